@@ -10,6 +10,21 @@
 #define LWIP_UDP 1
 #define LWIP_SO_RCVBUF 1
 #define LWIP_TIMEVAL_PRIVATE 0
+
+// lwIP's DNS table is the modem's name cache, answers are kept for their TTL.
+// Room for the speed dials, all looked up at once after WiFi connects
+#define DNS_TABLE_SIZE 16
+#define DNS_MAX_REQUESTS DNS_TABLE_SIZE
+#define DNS_MAX_NAME_LENGTH 80
+
+// Incoming calls wait in a short accept backlog, and callers turned away while
+// the modem is busy are reset (SO_LINGER of 0) rather than closed
+#define TCP_LISTEN_BACKLOG 1
+#define LWIP_SO_LINGER 1
+// 4 calls, a second attempt racing a dial, the listener, a caller being
+// turned away and the SMB sessions
+#define MEMP_NUM_NETCONN 10
+#define MEMP_NUM_TCP_PCB 10
 #if !NO_SYS
 #define TCPIP_THREAD_STACKSIZE 1024
 #define DEFAULT_THREAD_STACKSIZE 1024
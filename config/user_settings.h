@@ -69,22 +69,24 @@ extern "C" {
 #endif
 
 /* Wolf Single Precision Math */
+/* Fixed size code for RSA-2048, DH-2048 and P-256, much quicker than fast
+ * math on the Cortex-M0+.  Fast math stays for the other sizes */
 #undef WOLFSSL_SP
-#if 0
+#if 1
     #define WOLFSSL_SP
     #define WOLFSSL_SP_SMALL      /* use smaller version of code */
     #define WOLFSSL_HAVE_SP_RSA
     #define WOLFSSL_HAVE_SP_DH
     #define WOLFSSL_HAVE_SP_ECC
     //#define WOLFSSL_SP_CACHE_RESISTANT
-    #define WOLFSSL_SP_MATH     /* only SP math - eliminates fast math code */
+    //#define WOLFSSL_SP_MATH     /* only SP math - eliminates fast math code */
 
     /* SP Assembly Speedups */
     #define WOLFSSL_SP_ASM      /* required if using the ASM versions */
     //#define WOLFSSL_SP_ARM32_ASM
     //#define WOLFSSL_SP_ARM64_ASM
-    //#define WOLFSSL_SP_ARM_THUMB_ASM
-    #define WOLFSSL_SP_ARM_CORTEX_M_ASM
+    #define WOLFSSL_SP_ARM_THUMB_ASM    /* Thumb-1, the RP2040's Cortex-M0+ */
+    //#define WOLFSSL_SP_ARM_CORTEX_M_ASM
 #endif
 
 /* ------------------------------------------------------------------------- */
@@ -112,8 +114,9 @@ extern "C" {
 #if 1
     #ifdef USE_FAST_MATH
         /* Maximum math bits (Max RSA key bits * 2) */
+        /* 4096 bit roots, like ISRG Root X1, sign many TLS intermediates */
         #undef  FP_MAX_BITS
-        #define FP_MAX_BITS     4096
+        #define FP_MAX_BITS     8192
     #endif
 
     /* half as much memory but twice as slow */
@@ -155,7 +158,7 @@ extern "C" {
         //#define HAVE_ECC192
         //#define HAVE_ECC224
         #undef NO_ECC256
-        //#define HAVE_ECC384
+        #define HAVE_ECC384     /* ECDSA TLS roots, ISRG Root X2 and GTS Root R4 */
         //#define HAVE_ECC521
     #endif
 
@@ -247,8 +250,10 @@ extern "C" {
 	#undef  HAVE_AESGCM
     #define HAVE_AESGCM
 
-    /* GCM Method: GCM_SMALL, GCM_WORD32 or GCM_TABLE */
-    #define GCM_SMALL
+    /* GCM Method: GCM_SMALL, GCM_WORD32, GCM_TABLE or GCM_TABLE_4BIT */
+    /* 4 bit tables are 256 bytes per key and many times quicker than
+     * GCM_SMALL's bit at a time GHASH */
+    #define GCM_TABLE_4BIT
 
     #undef  WOLFSSL_AES_DIRECT
     //#define WOLFSSL_AES_DIRECT
@@ -274,9 +279,10 @@ extern "C" {
 #endif
 
 /* ChaCha20 / Poly1305 */
+/* Quicker than AES in software.  wolfSSH 1.4.12 does not offer it, TLS does */
 #undef HAVE_CHACHA
 #undef HAVE_POLY1305
-#if 0
+#if 1
     #define HAVE_CHACHA
     #define HAVE_POLY1305
 
@@ -286,14 +292,15 @@ extern "C" {
 #endif
 
 /* Ed25519 / Curve25519 */
+/* X25519 key exchange for TLS.  wolfSSH 1.4.12 only knows the name */
 #undef HAVE_CURVE25519
 #undef HAVE_ED25519
-#if 0
+#if 1
     #define HAVE_CURVE25519
-    #define HAVE_ED25519 /* ED25519 Requires SHA512 */
+    //#define HAVE_ED25519 /* ED25519 Requires SHA512 */
 
     /* Optionally use small math (less flash usage, but much slower) */
-    #if 1
+    #if 0
         #define CURVED25519_SMALL
     #endif
 #endif
@@ -540,7 +547,7 @@ extern unsigned int my_rng_seed_gen(void);
 #endif
 
 #undef WOLFSSL_KEY_GEN
-#if 0
+#if 1   /* The modem's SSH key is made and exported as DER (AT$SSHKEYGEN) */
     #define WOLFSSL_KEY_GEN
 #endif
 
@@ -567,12 +574,21 @@ extern unsigned int my_rng_seed_gen(void);
 #define WOLFSSL_LOG_PRINTF
 
 /* TLS Session Cache */
-#if 0
+/* The modem keeps the sessions it resumes itself, by host */
+#if 1
     #define SMALL_SESSION_CACHE
 #else
     #define NO_SESSION_CACHE
 #endif
 
+/* TLS 1.3 resumption tickets, and TLS 1.2 ones */
+#undef  HAVE_SESSION_TICKET
+#define HAVE_SESSION_TICKET
+
+/* Servers sharing an address pick the certificate by SNI */
+#undef  HAVE_SNI
+#define HAVE_SNI
+
 
 /* ------------------------------------------------------------------------- */
 /* Disable Features */
@@ -0,0 +1,320 @@
+.FEATURE    LABELS_WITHOUT_COLONS
+.DEFINE EQU =
+.DEFINE DFB .BYTE
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;                                              ;
+; PICO W MODEM CARD PRODOS BLOCK DRIVER        ;
+;                                              ;
+;   STEFAN WESSELS, 2023                       ;
+;                                              ;
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;                                              ;
+; THE CARD ANSWERS AS A PRODOS BLOCK DEVICE    ;
+; WITH TWO DRIVES, THE PICO W'S VSDRIVE 1 AND  ;
+; 2.  BLOCKS GO BACK AND FORTH AS VSDRIVE      ;
+; COMMANDS, BUT THROUGH THE CARD'S DATA        ;
+; REGISTER RATHER THAN A SERIAL LINE.          ;
+;                                              ;
+; THE $CN00 PAGE BOOTS AND ENTERS THE DRIVER   ;
+; IN THE $C800 ROM WITH $N0 IN X.              ;
+;                                              ;
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; PRODOS DRIVER ZERO PAGE ;
+;;;;;;;;;;;;;;;;;;;;;;;;;;;
+PCMD    EQU $42         ; 0 STATUS, 1 READ, 2 WRITE, 3 FORMAT
+PUNIT   EQU $43         ; DSSS0000
+PBUF    EQU $44         ; BUFFER POINTER
+PBLK    EQU $46         ; BLOCK NUMBER
+;;;;;;;;;;;;;
+; AUTOSTART ;
+;;;;;;;;;;;;;
+BOOTLO  EQU $00         ; ($00) IS $CN00 WHILE SCANNING SLOTS
+BOOTHI  EQU $01
+STACK   EQU $0100
+BOOTBUF EQU $0800       ; BLOCK 0 LOADS HERE
+BASIC   EQU $E000
+SLOOP   EQU $FABA       ; TRY THE NEXT SLOT DOWN
+ROMSOFF EQU $CFFF       ; DISABLES THE $C800 ROMS
+;;;;;;;;;;;;;;;;;;;;;;;;;;
+; CARD ADDRESSES (+$N0)  ;
+;;;;;;;;;;;;;;;;;;;;;;;;;;
+TDREG   EQU $C088       ; TO THE PICO W
+RDREG   EQU $C088       ; FROM THE PICO W
+STREG   EQU $C089
+RDRF    EQU $08         ; A BYTE CAN BE READ
+TDRE    EQU $10         ; A BYTE CAN BE WRITTEN
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; VSDRIVE:  C5 CMD BLKLO BLKHI CHECKSUM  ;
+; CMD = 3 + 2 * UNIT READ, 2 + 2 * UNIT  ;
+; WRITE.  A READ IS ANSWERED WITH THE    ;
+; COMMAND, TIME, DATE AND A CHECKSUM,    ;
+; THEN 512 BYTES AND THEIR XOR.  A WRITE ;
+; IS FOLLOWED BY 512 BYTES AND THEIR XOR ;
+; AND ANSWERED WITH THE COMMAND.         ;
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+SYNC    EQU $C5
+RHEADER EQU 9           ; BYTES BEFORE THE BLOCK IN A READ ANSWER
+WACK    EQU 5           ; BYTES IN A WRITE ANSWER
+TIMEOUT EQU 7           ; * 0.85 SECONDS FOR THE PICO W TO ANSWER
+;;;;;;;;;;;;;;;;;
+; PRODOS ERRORS ;
+;;;;;;;;;;;;;;;;;
+BADCMD  EQU $01
+IOERR   EQU $27
+NODEV   EQU $28
+
+    .REPEAT 7,COUNT
+    .SCOPE
+
+slot  = COUNT + 1
+N0    = slot * $10
+
+.segment .sprintf("io_sel%d",slot)
+
+        LDX #$20        ; $CN01=$20 $CN03=$00 $CN05=$03:
+        LDY #$00        ; A PRODOS BLOCK DEVICE
+        LDX #$03
+        STX $3C         ; $CN07=$3C: NOT A SMARTPORT
+;
+; BOOT: READ BLOCK 0 OF DRIVE 1 TO $0800 AND RUN IT
+;
+        LDA #N0
+        STA PUNIT
+        LDA #$01
+        STA PCMD
+        LDA #$00
+        STA PBUF
+        STA PBLK
+        STA PBLK+1
+        LDA #>BOOTBUF
+        STA PBUF+1
+        JSR DRIVER
+        BCS BOOTFAIL
+        LDX #N0         ; BOOT CODE WANTS $N0 IN X
+        JMP BOOTBUF+1
+BOOTFAIL LDA BOOTLO     ; SCANNING THE SLOTS?
+        BNE BOOTBAS
+        LDA BOOTHI
+        CMP #$C0+slot
+        BNE BOOTBAS
+        JMP SLOOP
+BOOTBAS JMP BASIC
+;
+; PRODOS ENTRY.  THE REST IS IN THE $C800 ROM, WITH X = $N0
+;
+DRIVER  BIT ROMSOFF     ; OTHER CARDS LET GO OF $C800
+        LDX #N0         ; AND THIS FETCH SELECTS OURS
+        JMP BLOCKIO
+
+.segment .sprintf("io_id%d",slot)
+
+        DFB $00,$00     ; BLOCK COUNT: ASK STATUS
+        DFB $97         ; REMOVABLE, 2 VOLUMES, STATUS, READ, WRITE
+        DFB <DRIVER
+
+    .ENDSCOPE
+    .ENDREP
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;                                 ;
+; C800 SPACE: SHARED BY ALL SLOTS ;
+;                                 ;
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+.segment "c800"
+
+;
+; PRODOS ENTRY, FROM $CN00 WITH X = $N0
+;
+BLOCKIO LDA PCMD
+        BNE DRW
+        LDX #$FF        ; STATUS: THE SIZE IS LEFT TO THE VOLUME
+        LDY #$FF
+        CLC
+        RTS
+DRW     CMP #$03
+        BCC FLUSH
+        LDA #BADCMD
+        RTS             ; <C SET>
+;
+; DROP WHAT IS LEFT OF AN ANSWER THAT TIMED OUT
+;
+FLUSH   LDA STREG,X
+        AND #RDRF
+        BEQ DCMD
+        LDA RDREG,X
+        BCC FLUSH       ; <ALWAYS>
+;
+; SEND THE VSDRIVE COMMAND
+;
+DCMD    LDA PUNIT
+        ASL A           ; C = DRIVE 2
+        LDA #$01
+        ROL A
+        ASL A           ; 4 OR 6
+        SEC
+        SBC PCMD        ; READ 3 OR 5, WRITE 2 OR 4
+        PHA
+        LDA #SYNC
+        JSR SEND
+        PLA
+        PHA
+        JSR SEND
+        LDA PBLK
+        JSR SEND
+        LDA PBLK+1
+        JSR SEND
+        PLA
+        EOR #SYNC
+        EOR PBLK
+        EOR PBLK+1
+        JSR SEND
+        LDA PCMD
+        LSR A
+        BCC DWRITE
+;
+; READ: SKIP THE HEADER, TAKE THE BLOCK AND CHECK IT
+;
+        LDA #RHEADER
+        JSR SKIP
+        BCS DNODEV
+        LDY #$00
+DREAD1  LDA STREG,X    ; THE BLOCK FOLLOWS THE HEADER
+        AND #RDRF       ; AT ONCE, SO NO TIMEOUT HERE
+        BEQ DREAD1
+        LDA RDREG,X
+        STA (PBUF),Y
+        INY
+        BNE DREAD1
+        INC PBUF+1
+DREAD2  LDA STREG,X
+        AND #RDRF
+        BEQ DREAD2
+        LDA RDREG,X
+        STA (PBUF),Y
+        INY
+        BNE DREAD2
+        DEC PBUF+1
+        JSR RECV        ; CHECKSUM
+        BCS DNODEV
+        PHA
+        JSR XORBUF
+        TSX
+        EOR STACK+1,X
+        TAY
+        PLA
+        TYA
+        BNE DIOERR      ; THE PICO W COULD NOT READ THE BLOCK
+        CLC
+        RTS
+;
+; WRITE: SEND THE BLOCK AND ITS CHECKSUM, WAIT FOR THE ACK
+;
+DWRITE  JSR XORBUF
+        PHA
+        LDY #$00
+DWRITE1 LDA STREG,X
+        AND #TDRE
+        BEQ DWRITE1
+        LDA (PBUF),Y
+        STA TDREG,X
+        INY
+        BNE DWRITE1
+        INC PBUF+1
+DWRITE2 LDA STREG,X
+        AND #TDRE
+        BEQ DWRITE2
+        LDA (PBUF),Y
+        STA TDREG,X
+        INY
+        BNE DWRITE2
+        DEC PBUF+1
+        PLA
+        JSR SEND
+        LDA #WACK       ; NO ACK IF THE IMAGE IS READ ONLY
+        JSR SKIP
+        BCS DIOERR
+        LDA #$00
+        RTS
+DNODEV  LDA #NODEV
+        RTS             ; <C SET>
+DIOERR  LDA #IOERR
+        SEC
+        RTS
+;
+; SEND A TO THE PICO W
+;
+SEND    PHA
+SEND1   LDA STREG,X
+        AND #TDRE
+        BEQ SEND1
+        PLA
+        STA TDREG,X
+        RTS
+;
+; RECEIVE A BYTE INTO A, C SET IF THE PICO W DOES NOT ANSWER.
+; USES Y
+;
+RECV    LDA #TIMEOUT
+        PHA
+        LDA #$00
+        PHA
+        TAY
+RECV1   LDA STREG,X
+        AND #RDRF
+        BNE RECV3
+        DEY
+        BNE RECV1
+        TSX
+        DEC STACK+1,X
+        BNE RECV2
+        DEC STACK+2,X
+RECV2   PHP
+        JSR SLOTX
+        PLP
+        BNE RECV1
+        PLA
+        PLA
+        SEC
+        RTS
+RECV3   PLA
+        PLA
+        LDA RDREG,X
+        CLC
+        RTS
+;
+; RECEIVE AND DROP A BYTES, C SET IF THE PICO W DOES NOT ANSWER
+;
+SKIP    PHA
+SKIP1   JSR RECV
+        BCS SKIP2
+        TSX
+        DEC STACK+1,X
+        PHP
+        JSR SLOTX
+        PLP
+        BNE SKIP1
+SKIP2   PLA
+        RTS
+;
+; X = $N0 AGAIN AFTER A TSX
+;
+SLOTX   LDA PUNIT
+        AND #$70
+        TAX
+        RTS
+;
+; A = XOR OF THE 512 BYTES AT (PBUF)
+;
+XORBUF  LDA #$00
+        TAY
+XORBUF1 EOR (PBUF),Y
+        INY
+        BNE XORBUF1
+        INC PBUF+1
+XORBUF2 EOR (PBUF),Y
+        INY
+        BNE XORBUF2
+        DEC PBUF+1
+        RTS
@@ -0,0 +1,81 @@
+/*
+  CoreUART.cpp - host build stand-in for core 1
+  The "UART" is the host's stdin/stdout (put in raw mode when it is a tty)
+  Stefan Wessels, 2023
+*/
+#include <poll.h>
+#include <unistd.h>
+#include <termios.h>
+
+#include "RingBuf.h"
+#include "CoreUART.h"
+
+namespace Modem
+{
+extern RingBuffer c0cmd;
+extern RingBuffer c0rx;
+extern RingBuffer c0tx;
+};
+
+namespace CoreUART
+{
+
+static struct termios savedTermios;
+
+static void restoreTerminal()
+{
+    tcsetattr(STDIN_FILENO, TCSAFLUSH, &savedTermios);
+}
+
+void init()
+{
+    if (isatty(STDIN_FILENO) && !tcgetattr(STDIN_FILENO, &savedTermios))
+    {
+        struct termios raw = savedTermios;
+        cfmakeraw(&raw);
+        raw.c_oflag |= OPOST | ONLCR;
+        tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw);
+        atexit(restoreTerminal);
+    }
+}
+
+void uart_interface(void)
+{
+    while (true)
+    {
+        if (Modem::c0cmd.available())
+        {
+            // There is no baud rate on the host, so only 'S' (stop) matters
+            uint8_t chr = Modem::c0cmd.Read();
+            if (chr == 'B')
+                Modem::c0cmd.Read();
+            else if (chr == 'S')
+                break;
+        }
+
+        // Terminal to core 0, straight into the free span of c0rx
+        uint8_t *span;
+        size_t len = Modem::c0rx.write_span(&span);
+        struct pollfd pfd = {STDIN_FILENO, POLLIN, 0};
+        if (len && poll(&pfd, 1, Modem::c0tx.is_empty() ? 1 : 0) > 0)
+        {
+            ssize_t got = read(STDIN_FILENO, span, len);
+            if (got > 0)
+                Modem::c0rx.commit(got);
+            else if (got == 0)
+                break;  // stdin closed
+        }
+
+        // Core 0 to the terminal
+        const uint8_t *out;
+        while ((len = Modem::c0tx.read_span(&out)))
+        {
+            ssize_t put = write(STDOUT_FILENO, out, len);
+            if (put <= 0)
+                break;
+            Modem::c0tx.consume(put);
+        }
+    }
+}
+
+}; // namespace CoreUART
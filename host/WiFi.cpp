@@ -0,0 +1,130 @@
+/*
+  WiFi.cpp - host build stand-in for the WiFiClass
+  The host is always "associated" once begin() is called, names resolve with
+  getaddrinfo and WiFiClient uses the host's sockets directly
+  Stefan Wessels, 2023
+*/
+#include "WiFi.h"
+#include <netdb.h>
+#include <arpa/inet.h>
+
+wcList<_wifi_node> WiFiClass::_wifi_nodes;
+int WiFiClass::itf = CYW43_ITF_STA;
+String WiFiClass::wifi_ssid = "";
+bool WiFiClass::roaming = true;
+
+WiFiClass::WiFiClass()
+{
+}
+
+void WiFiClass::init()
+{
+}
+
+char *WiFiClass::firmwareVersion()
+{
+    return nullptr;
+}
+
+int WiFiClass::begin(const char *ssid)
+{
+    wifi_ssid = ssid;
+    return 0;
+}
+
+int WiFiClass::begin(const char *ssid, uint8_t key_idx, const char *key)
+{
+    wifi_ssid = ssid;
+    return 0;
+}
+
+int WiFiClass::begin(const char *ssid, const char *passphrase)
+{
+    wifi_ssid = ssid;
+    return 0;
+}
+
+int WiFiClass::disconnect()
+{
+    wifi_ssid = "";
+    return 0;
+}
+
+uint8_t *WiFiClass::macAddress(uint8_t *mac)
+{
+    memset(mac, 0, 6);
+    return mac;
+}
+
+IPAddress WiFiClass::localIP()
+{
+    return wifi_ssid.length() ? IPAddress(127, 0, 0, 1) : IPAddress(0, 0, 0, 0);
+}
+
+IPAddress WiFiClass::subnetMask()
+{
+    return wifi_ssid.length() ? IPAddress(255, 0, 0, 0) : IPAddress(0, 0, 0, 0);
+}
+
+IPAddress WiFiClass::gatewayIP()
+{
+    return localIP();
+}
+
+char *WiFiClass::SSID()
+{
+    return (char *)wifi_ssid.c_str();
+}
+
+int8_t WiFiClass::scanNetworks()
+{
+    _wifi_nodes.FlushList();
+    return 0;
+}
+
+// A wired host has no signal to watch or AP to move to
+int32_t WiFiClass::RSSI()
+{
+    return 0;
+}
+
+uint8_t *WiFiClass::BSSID(uint8_t *bssid)
+{
+    memset(bssid, 0, 6);
+    return bssid;
+}
+
+void WiFiClass::roam()
+{
+}
+
+uint8_t WiFiClass::status()
+{
+    return wifi_ssid.length() ? CYW43_LINK_UP : CYW43_LINK_DOWN;
+}
+
+int WiFiClass::hostByName(const char *aHostname, IPAddress &aResult)
+{
+    struct addrinfo hints = {}, *res = nullptr;
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(aHostname, nullptr, &hints, &res) == 0 && res)
+    {
+        aResult = ((struct sockaddr_in *)res->ai_addr)->sin_addr.s_addr;
+        freeaddrinfo(res);
+        return 1;
+    }
+    aResult.fromString("0.0.0.0");
+    return 0;
+}
+
+int WiFiClass::resolve(const char *aHostname, IPAddress &aResult)
+{
+    return hostByName(aHostname, aResult);
+}
+
+void WiFiClass::prefetch(const char *aHostname)
+{
+}
+
+WiFiClass WiFi;
@@ -0,0 +1,127 @@
+/*
+  autobaud_test.cpp - checks the autobaud start bit search on a synthetic RX line
+  The line is sampled the way Serial_::measureBit does, in slices much shorter
+  than the idle time with gaps between them, and the start bit found must be
+  the one after the idle line, never one in the middle of the text
+    autobaud_test
+  Stefan Wessels, 2023
+*/
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+
+#include "StartBit.h"
+
+#define IDLE_US     5000    // CoreUART's AUTOBAUD_IDLE_US
+#define SLICE_US    1000    // CoreUART's AUTOBAUD_SLICE_US
+#define GAP_US      40      // Time the pump spends on its other work between slices
+
+/*
+ * An RX line: high, except for the low spans in lows
+ */
+struct Line
+{
+    struct Span
+    {
+        uint32_t from, to;
+    };
+    std::vector<Span> lows;
+
+    // Add the character c, 8N1 at baud, starting at us.  Returns when it ends
+    uint32_t character(uint32_t us, uint8_t c, uint32_t baud)
+    {
+        uint32_t bitUs = 1000000 / baud;
+        int bits = 0x200 | (c << 1);    // Start bit, data LSB first, stop bit
+        for (int i = 0; i < 10; i++, us += bitUs)
+        {
+            if (!(bits & (1 << i)))
+                lows.push_back({us, us + bitUs});
+        }
+        return us;
+    }
+
+    bool level(uint32_t us) const
+    {
+        for (const Span &s : lows)
+        {
+            if (us >= s.from && us < s.to)
+                return false;
+        }
+        return true;
+    }
+};
+
+/*
+ * Search the way measureBit does, one slice at a time, from us until end.
+ * Returns when the start bit was found, and the length of the low pulse
+ */
+static bool search(const Line &line, uint32_t us, uint32_t end, uint32_t *found, uint32_t *lowUs)
+{
+    StartBit startBit;
+
+    while (us < end)
+    {
+        uint32_t start = us;
+        while (!startBit.sample(line.level(us), us, IDLE_US))
+        {
+            if (++us - start > SLICE_US)
+                break;
+        }
+        if (us - start <= SLICE_US)
+        {
+            *found = us;
+            while (!line.level(us))
+                us++;
+            *lowUs = us - *found;
+            return true;
+        }
+        us += GAP_US;
+    }
+    return false;
+}
+
+static int failures = 0;
+
+static void check(bool ok, const char *what)
+{
+    printf("%s: %s\n", ok ? "PASS" : "FAIL", what);
+    if (!ok)
+        failures++;
+}
+
+int main(void)
+{
+    uint32_t found, lowUs;
+
+    // "AT" after 20ms of idle line, at 9600
+    {
+        Line line;
+        uint32_t at = 20000;
+        line.character(line.character(at, 'A', 9600), 'T', 9600);
+        bool ok = search(line, 0, 40000, &found, &lowUs);
+        check(ok && found == at && lowUs == 1000000 / 9600, "start bit after idle line, across slices");
+    }
+
+    // Text with 2ms between characters never leaves the line idle long enough,
+    // until the "AT" that follows 6ms of quiet
+    {
+        Line line;
+        uint32_t us = 0;
+        for (int i = 0; i < 20; i++)
+            us = line.character(us, 'x', 2400) + 2000;
+        uint32_t at = us + 6000;
+        line.character(line.character(at, 'A', 19200), 'T', 19200);
+        bool ok = search(line, 0, at + 10000, &found, &lowUs);
+        check(ok && found == at && lowUs == 1000000 / 19200, "no start bit inside text, then the AT");
+    }
+
+    // A line that is low when the search starts has not been idle
+    {
+        Line line;
+        line.lows.push_back({0, 3000});
+        line.character(4000, 'A', 9600);
+        check(!search(line, 0, 20000, &found, &lowUs), "no start bit without idle line before it");
+    }
+
+    return failures ? 1 : 0;
+}
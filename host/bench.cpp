@@ -0,0 +1,474 @@
+/*
+  bench.cpp - throughput and latency benchmark for the host build of the modem
+  This program plays the part of core 1 (a synthetic terminal on c0rx/c0tx)
+  and of the remote host (a socket server on 127.0.0.1) around an unmodified
+  Modem::loop(), and writes the results as JSON:
+    modem_bench [results.json] [bytes]
+  Stefan Wessels, 2023
+*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "RingBuf.h"
+
+namespace Modem
+{
+extern void pico_modem_main();
+extern void defaultSettings();
+extern RingBuffer c0rx;
+extern RingBuffer c0tx;
+extern int64_t connectUs;
+extern int64_t firstByteUs;
+};
+
+typedef std::chrono::steady_clock Clock;
+
+#define PLUS_GUARD_MS       1000    // Modem's PLUS_TIME
+#define LATENCY_SAMPLES     2000    // Bytes sent one at a time for the latency test
+#define LATENCY_GAP_US      200     // Time between those bytes
+#define WAIT_MS             10000   // Longest wait for any expected response
+
+static double seconds(Clock::time_point from, Clock::time_point to)
+{
+    return std::chrono::duration<double>(to - from).count();
+}
+
+/*
+ * The remote end.  Each accepted connection either sinks what the modem sends,
+ * recording when every data byte arrived, or sources a payload to the modem
+ */
+class Server
+{
+public:
+    enum Mode
+    {
+        SINK,
+        SOURCE
+    };
+
+    std::atomic<Mode> mode{SINK};
+    std::atomic<bool> telnet{false};
+    std::vector<uint8_t> payload;
+
+    // SINK results
+    std::mutex lock;
+    std::vector<Clock::time_point> arrivals;    // Per data byte
+    std::atomic<size_t> received{0};
+
+    int port = 0;
+
+    bool start()
+    {
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof(addr);
+        if (listenFd < 0 || bind(listenFd, (struct sockaddr *)&addr, len) || listen(listenFd, 4) ||
+            getsockname(listenFd, (struct sockaddr *)&addr, &len))
+            return false;
+        port = ntohs(addr.sin_port);
+        std::thread(&Server::acceptLoop, this).detach();
+        return true;
+    }
+
+    void reset()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        arrivals.clear();
+        received = 0;
+        iacState = 0;
+    }
+
+private:
+    int listenFd = -1;
+    int iacState = 0;
+
+    void acceptLoop()
+    {
+        while (true)
+        {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0)
+                return;
+            std::thread(&Server::connection, this, fd).detach();
+        }
+    }
+
+    void connection(int fd)
+    {
+        if (mode == SOURCE)
+        {
+            size_t sent = 0;
+            while (sent < payload.size())
+            {
+                ssize_t n = send(fd, &payload[sent], payload.size() - sent, 0);
+                if (n <= 0)
+                    break;
+                sent += n;
+            }
+        }
+
+        uint8_t buf[4096];
+        ssize_t n;
+        while ((n = recv(fd, buf, sizeof(buf), 0)) > 0)
+        {
+            Clock::time_point now = Clock::now();
+            std::lock_guard<std::mutex> guard(lock);
+            if (mode != SINK)
+                continue;
+            for (ssize_t i = 0; i < n; i++)
+            {
+                if (telnet && !isData(buf[i]))
+                    continue;
+                arrivals.push_back(now);
+                received++;
+            }
+        }
+        close(fd);
+    }
+
+    // Just enough telnet to count data bytes - IAC IAC is data, IAC cmd [opt] is not
+    bool isData(uint8_t c)
+    {
+        switch (iacState)
+        {
+        case 0:
+            if (c != 0xff)
+                return true;
+            iacState = 1;
+            return false;
+        case 1:
+            iacState = (c >= 0xfb && c <= 0xfe) ? 2 : 0;
+            return c == 0xff;
+        default:
+            iacState = 0;
+            return false;
+        }
+    }
+};
+
+/*
+ * The terminal.  Owns the core 1 side of both queues
+ */
+class Terminal
+{
+public:
+    std::string seen;
+
+    void send(const std::string &s)
+    {
+        Modem::c0rx.Write((const uint8_t *)s.data(), s.size());
+    }
+
+    // Drain c0tx, returning how many bytes were taken
+    size_t drain()
+    {
+        const uint8_t *span;
+        size_t len, total = 0;
+        while ((len = Modem::c0tx.read_span(&span)))
+        {
+            seen.append((const char *)span, len);
+            if (seen.size() > 4096)
+                seen.erase(0, seen.size() - 1024);
+            Modem::c0tx.consume(len);
+            total += len;
+        }
+        return total;
+    }
+
+    // Drain c0tx until text shows up, returns false on time out
+    bool waitFor(const char *text, int ms = WAIT_MS)
+    {
+        Clock::time_point end = Clock::now() + std::chrono::milliseconds(ms);
+        while (Clock::now() < end)
+        {
+            drain();
+            size_t at = seen.find(text);
+            if (at != std::string::npos)
+            {
+                seen.erase(0, at + strlen(text));
+                return true;
+            }
+            std::this_thread::yield();
+        }
+        return false;
+    }
+
+    bool command(const std::string &cmd, const char *reply)
+    {
+        seen.clear();
+        send(cmd + "\r");
+        return waitFor(reply);
+    }
+};
+
+struct Result
+{
+    std::string name;
+    bool ok = false;
+    double upBytesPerSec = 0;
+    double downBytesPerSec = 0;
+    double latencyUs[4] = {0, 0, 0, 0};     // p50, p90, p99, max
+    double escapeMs = 0;                    // Time to OK after the +++ guard time
+    double connectMs = 0;                   // ATDT to CONNECT
+    double firstByteMs = 0;                 // ATDT to the first byte from the host
+};
+
+static Server server;
+static Terminal term;
+
+// Data that avoids '+' so it can never look like an escape, and includes 0xff for telnet
+static std::vector<uint8_t> makePayload(size_t size)
+{
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        data[i] = (uint8_t)(i * 7 + 1);
+        if (data[i] == '+')
+            data[i] = '-';
+    }
+    return data;
+}
+
+/*
+ * Keep the terminal drained until count() reaches target, giving up only once
+ * nothing has moved for WAIT_MS, so any payload size can be used
+ */
+template <typename Count>
+static bool progress(Count count, size_t target)
+{
+    size_t last = 0;
+    Clock::time_point end = Clock::now() + std::chrono::milliseconds(WAIT_MS);
+    while (Clock::now() < end)
+    {
+        size_t now = count();
+        if (now >= target)
+            return true;
+        if (now != last)
+        {
+            last = now;
+            end = Clock::now() + std::chrono::milliseconds(WAIT_MS);
+        }
+        if (!term.drain())
+            std::this_thread::yield();
+    }
+    return false;
+}
+
+static bool dial()
+{
+    return term.command("ATDT127.0.0.1:" + std::to_string(server.port), "CONNECT");
+}
+
+// Send +++ and time how long after the guard time the OK arrives, then hang up
+static bool escapeAndHangUp(Result &r)
+{
+    term.drain();
+    term.seen.clear();
+    Clock::time_point sent = Clock::now();
+    term.send("+++");
+    if (!term.waitFor("OK"))
+        return false;
+    r.escapeMs = seconds(sent, Clock::now()) * 1000.0 - PLUS_GUARD_MS;
+    return term.command("ATH", "NO CARRIER");
+}
+
+static bool upload(Result &r, size_t size)
+{
+    std::vector<uint8_t> data = makePayload(size);
+    server.mode = Server::SINK;
+    server.reset();
+    if (!dial())
+        return false;
+
+    Clock::time_point start = Clock::now();
+    size_t at = 0;
+    while (at < size)
+    {
+        uint8_t *span;
+        size_t len = Modem::c0rx.write_span(&span);
+        if (!len)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        if (len > size - at)
+            len = size - at;
+        memcpy(span, &data[at], len);
+        Modem::c0rx.commit(len);
+        at += len;
+        term.drain();
+    }
+    if (!progress([] { return (size_t)server.received; }, size))
+        return false;
+    {
+        std::lock_guard<std::mutex> guard(server.lock);
+        r.upBytesPerSec = size / seconds(start, server.arrivals[size - 1]);
+    }
+    return escapeAndHangUp(r);
+}
+
+static bool download(Result &r, size_t size)
+{
+    std::vector<uint8_t> data = makePayload(size);
+    size_t expect = size;
+    if (server.telnet)
+    {
+        // On the wire every 0xff is doubled
+        server.payload.clear();
+        for (uint8_t c : data)
+        {
+            server.payload.push_back(c);
+            if (c == 0xff)
+                server.payload.push_back(c);
+        }
+    }
+    else
+    {
+        server.payload = data;
+    }
+    server.mode = Server::SOURCE;
+    server.reset();
+    Clock::time_point dialed = Clock::now();
+    if (!dial())
+        return false;
+
+    // The rest of the CONNECT line is the modem's, not the host's
+    if (!term.waitFor("\r\n"))
+        return false;
+    Clock::time_point start = Clock::now();
+    r.connectMs = seconds(dialed, start) * 1000.0;
+    // Anything after it is payload that came in with the result, too close
+    // behind it for the terminal to time, so the modem's own gap from the
+    // CONNECT to reading the first byte from the socket is used
+    size_t got = term.seen.size();
+    term.seen.clear();
+    if (got && Modem::firstByteUs >= Modem::connectUs)
+        r.firstByteMs = r.connectMs + (Modem::firstByteUs - Modem::connectUs) / 1000.0;
+    if (!progress([&] {
+            got += term.drain();
+            if (got && !r.firstByteMs)
+                r.firstByteMs = seconds(dialed, Clock::now()) * 1000.0;
+            return got;
+        }, expect))
+        return false;
+    r.downBytesPerSec = expect / seconds(start, Clock::now());
+    return escapeAndHangUp(r);
+}
+
+static bool latency(Result &r)
+{
+    std::vector<Clock::time_point> sent(LATENCY_SAMPLES);
+    server.mode = Server::SINK;
+    server.reset();
+    if (!dial())
+        return false;
+
+    for (size_t i = 0; i < LATENCY_SAMPLES; i++)
+    {
+        sent[i] = Clock::now();
+        Modem::c0rx.Write((uint8_t)('a' + i % 26));
+        Clock::time_point next = sent[i] + std::chrono::microseconds(LATENCY_GAP_US);
+        while (Clock::now() < next)
+            if (!term.drain())
+                std::this_thread::yield();
+    }
+    if (!progress([] { return (size_t)server.received; }, LATENCY_SAMPLES))
+        return false;
+
+    std::vector<double> us(LATENCY_SAMPLES);
+    {
+        std::lock_guard<std::mutex> guard(server.lock);
+        for (size_t i = 0; i < LATENCY_SAMPLES; i++)
+            us[i] = seconds(sent[i], server.arrivals[i]) * 1e6;
+    }
+    std::sort(us.begin(), us.end());
+    r.latencyUs[0] = us[LATENCY_SAMPLES * 50 / 100];
+    r.latencyUs[1] = us[LATENCY_SAMPLES * 90 / 100];
+    r.latencyUs[2] = us[LATENCY_SAMPLES * 99 / 100];
+    r.latencyUs[3] = us.back();
+    return escapeAndHangUp(r);
+}
+
+static Result run(const char *name, bool telnet, size_t size)
+{
+    Result r;
+    r.name = name;
+    server.telnet = telnet;
+    if (!term.command(telnet ? "ATNET1" : "ATNET0", "OK"))
+        return r;
+    r.ok = upload(r, size) && download(r, size) && latency(r);
+    return r;
+}
+
+static void writeJson(FILE *f, const std::vector<Result> &results, size_t size)
+{
+    fprintf(f, "{\n  \"bytes\": %zu,\n  \"results\": [\n", size);
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const Result &r = results[i];
+        fprintf(f, "    {\n      \"mode\": \"%s\",\n      \"ok\": %s,\n", r.name.c_str(), r.ok ? "true" : "false");
+        fprintf(f, "      \"serial_to_socket_bytes_per_sec\": %.0f,\n", r.upBytesPerSec);
+        fprintf(f, "      \"socket_to_serial_bytes_per_sec\": %.0f,\n", r.downBytesPerSec);
+        fprintf(f, "      \"serial_to_socket_latency_us\": {\"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, \"max\": %.1f},\n",
+                r.latencyUs[0], r.latencyUs[1], r.latencyUs[2], r.latencyUs[3]);
+        fprintf(f, "      \"escape_detect_ms_after_guard\": %.2f,\n", r.escapeMs);
+        fprintf(f, "      \"connect_ms\": %.2f,\n", r.connectMs);
+        fprintf(f, "      \"first_byte_ms\": %.2f\n    },\n", r.firstByteMs);
+    }
+    // The host build has no wolfSSH, so SSH can only be measured on the device
+    fprintf(f, "    {\n      \"mode\": \"ssh\",\n      \"ok\": false,\n      \"skipped\": \"SSH is not available in the host build\"\n    }\n");
+    fprintf(f, "  ]\n}\n");
+}
+
+int main(int argc, char *argv[])
+{
+    const char *out = argc > 1 ? argv[1] : "bench_results.json";
+    size_t size = argc > 2 ? strtoul(argv[2], nullptr, 10) : 1024 * 1024;
+
+    signal(SIGPIPE, SIG_IGN);
+    if (!server.start())
+    {
+        fprintf(stderr, "Could not start the local server\n");
+        return 1;
+    }
+
+    Modem::defaultSettings();
+    std::thread(Modem::pico_modem_main).detach();
+    if (!term.command("ATE0", "OK"))
+    {
+        fprintf(stderr, "The modem did not answer\n");
+        return 1;
+    }
+
+    std::vector<Result> results;
+    results.push_back(run("raw", false, size));
+    results.push_back(run("telnet", true, size));
+
+    FILE *f = fopen(out, "w");
+    if (!f)
+    {
+        fprintf(stderr, "Could not write %s\n", out);
+        return 1;
+    }
+    writeJson(f, results, size);
+    fclose(f);
+    writeJson(stdout, results, size);
+    fflush(stdout);
+
+    // Modem::loop() never returns, so leave without unwinding its thread
+    _exit(results[0].ok && results[1].ok ? 0 : 1);
+}
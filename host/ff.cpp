@@ -0,0 +1,140 @@
+/*
+  ff.cpp - host build stand-in for FatFs
+  "0:/path" is the file path under $MODEM_SD_ROOT (or ./sd)
+  Stefan Wessels, 2023
+*/
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <string>
+
+#include "ff.h"
+
+FRESULT f_mount(FATFS *fs, const TCHAR *path, BYTE opt)
+{
+    const char *root = getenv("MODEM_SD_ROOT");
+    struct stat st;
+    if (stat(root ? root : "sd", &st) || !S_ISDIR(st.st_mode))
+        return FR_NOT_READY;
+    fs->fs_type = 1;
+    return FR_OK;
+}
+
+// The host path of a path on volume 0:
+static std::string hostPath(const TCHAR *path)
+{
+    const char *root = getenv("MODEM_SD_ROOT");
+    if (!strncmp(path, "0:", 2))
+        path += 2;
+    return std::string(root ? root : "sd") + "/" + path;
+}
+
+FRESULT f_open(FIL *fp, const TCHAR *path, BYTE mode)
+{
+    std::string name = hostPath(path);
+
+    int flags = (mode & FA_WRITE) ? ((mode & FA_READ) ? O_RDWR : O_WRONLY) : O_RDONLY;
+    if (mode & FA_CREATE_ALWAYS)
+        flags |= O_CREAT | O_TRUNC;
+    else if (mode & FA_CREATE_NEW)
+        flags |= O_CREAT | O_EXCL;
+    else if (mode & FA_OPEN_ALWAYS)
+        flags |= O_CREAT;
+
+    fp->fd = open(name.c_str(), flags, 0644);
+    if (fp->fd < 0)
+        return errno == ENOENT ? FR_NO_FILE : errno == EEXIST ? FR_EXIST : FR_DENIED;
+
+    struct stat st;
+    fstat(fp->fd, &st);
+    fp->fptr = 0;
+    fp->size = st.st_size;
+    fp->cltbl = NULL;
+    return FR_OK;
+}
+
+FRESULT f_close(FIL *fp)
+{
+    close(fp->fd);
+    fp->fd = -1;
+    return FR_OK;
+}
+
+FRESULT f_read(FIL *fp, void *buff, UINT btr, UINT *br)
+{
+    ssize_t n = pread(fp->fd, buff, btr, fp->fptr);
+    if (n < 0)
+        return FR_DISK_ERR;
+    fp->fptr += n;
+    *br = (UINT)n;
+    return FR_OK;
+}
+
+FRESULT f_write(FIL *fp, const void *buff, UINT btw, UINT *bw)
+{
+    // As in FatFs, a file in fast seek mode can not grow
+    if (fp->cltbl && fp->fptr + btw > fp->size)
+        btw = fp->fptr < fp->size ? (UINT)(fp->size - fp->fptr) : 0;
+    ssize_t n = pwrite(fp->fd, buff, btw, fp->fptr);
+    if (n < 0)
+        return FR_DISK_ERR;
+    fp->fptr += n;
+    if (fp->fptr > fp->size)
+        fp->size = fp->fptr;
+    *bw = (UINT)n;
+    return FR_OK;
+}
+
+FRESULT f_lseek(FIL *fp, FSIZE_t ofs)
+{
+    // Every file is contiguous on the host, so the link map is one fragment
+    if (ofs == CREATE_LINKMAP)
+    {
+        if (!fp->cltbl || fp->cltbl[0] < 4)
+            return FR_NOT_ENOUGH_CORE;
+        fp->cltbl[0] = 4;
+        return FR_OK;
+    }
+    // Seeking past the end grows a file that is not in fast seek mode
+    if (ofs > fp->size)
+    {
+        if (fp->cltbl)
+            ofs = fp->size;
+        else if (ftruncate(fp->fd, ofs))
+            return FR_DENIED;
+        else
+            fp->size = ofs;
+    }
+    fp->fptr = ofs;
+    return FR_OK;
+}
+
+FRESULT f_expand(FIL *fp, FSIZE_t fsz, BYTE opt)
+{
+    if (fp->size || ftruncate(fp->fd, fsz))
+        return FR_DENIED;
+    fp->size = fsz;
+    return FR_OK;
+}
+
+FRESULT f_sync(FIL *fp)
+{
+    return fsync(fp->fd) ? FR_DISK_ERR : FR_OK;
+}
+
+FRESULT f_mkdir(const TCHAR *path)
+{
+    if (mkdir(hostPath(path).c_str(), 0755))
+        return errno == EEXIST ? FR_EXIST : errno == ENOENT ? FR_NO_PATH : FR_DENIED;
+    return FR_OK;
+}
+
+FRESULT f_unlink(const TCHAR *path)
+{
+    if (unlink(hostPath(path).c_str()))
+        return errno == ENOENT ? FR_NO_FILE : FR_DENIED;
+    return FR_OK;
+}
@@ -0,0 +1,86 @@
+/*
+  lwip.cpp - host build stand-in for the lwIP raw UDP API used by NTPClient
+  Stefan Wessels, 2023
+*/
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lwip/udp.h"
+
+#define NTP_PACKET_SIZE     48
+#define SEVENZYYEARS        2208988800UL
+
+const ip_addr_t ip_addr_any = {0};
+
+struct udp_pcb *udp_new()
+{
+    return (struct udp_pcb *)calloc(1, sizeof(struct udp_pcb));
+}
+
+void udp_remove(struct udp_pcb *pcb)
+{
+    free(pcb);
+}
+
+err_t udp_bind(struct udp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port)
+{
+    return pcb ? ERR_OK : ERR_ARG;
+}
+
+err_t udp_connect(struct udp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port)
+{
+    return pcb ? ERR_OK : ERR_ARG;
+}
+
+void udp_disconnect(struct udp_pcb *pcb)
+{
+}
+
+void udp_recv(struct udp_pcb *pcb, udp_recv_fn recv, void *recv_arg)
+{
+    pcb->recv = recv;
+    pcb->recv_arg = recv_arg;
+}
+
+/*
+ * The only datagram sent is an NTP request - answer it straight away from the host clock
+ */
+err_t udp_send(struct udp_pcb *pcb, struct pbuf *p)
+{
+    if (!pcb || !p || p->len < NTP_PACKET_SIZE)
+        return ERR_ARG;
+
+    if (pcb->recv)
+    {
+        uint8_t reply[NTP_PACKET_SIZE] = {0};
+        struct pbuf r = {reply, NTP_PACKET_SIZE, NTP_PACKET_SIZE};
+        uint32_t secs = (uint32_t)(time(NULL) + SEVENZYYEARS);
+
+        reply[0] = 0b00100100;      // LI 0, Version 4, Mode server
+        reply[1] = 1;               // Stratum 1
+        for (int i = 0; i < 4; i++)
+        {
+            reply[16 + i] = (uint8_t)(secs >> (24 - 8 * i)); // Reference timestamp
+            reply[40 + i] = (uint8_t)(secs >> (24 - 8 * i)); // Transmit timestamp
+        }
+        pcb->recv(pcb->recv_arg, pcb, &r, &ip_addr_any, 123);
+    }
+    return ERR_OK;
+}
+
+struct pbuf *pbuf_alloc(pbuf_layer layer, u16_t length, pbuf_type type)
+{
+    struct pbuf *p = (struct pbuf *)malloc(sizeof(struct pbuf) + length);
+    if (p)
+    {
+        p->payload = p + 1;
+        p->len = p->tot_len = length;
+    }
+    return p;
+}
+
+u8_t pbuf_free(struct pbuf *p)
+{
+    free(p);
+    return 1;
+}
@@ -0,0 +1,36 @@
+/*
+  main.cpp - entry point for the host build of the modem
+  Runs Modem::loop() on the main thread and the terminal pump on a second
+  thread standing in for core 1
+  Stefan Wessels, 2023
+*/
+#include <signal.h>
+#include "pico/multicore.h"
+#include "WiFi.h"
+#include "CoreUART.h"
+
+namespace Modem
+{
+extern void pico_modem_main();
+extern void defaultSettings();
+extern void loadSettings();
+extern bool sd_init_driver;
+};
+
+int main(void)
+{
+    // A dropped connection must not kill the process
+    signal(SIGPIPE, SIG_IGN);
+
+    // The SD card is a folder, which is always there
+    Modem::sd_init_driver = true;
+
+    Modem::defaultSettings();
+    Modem::loadSettings();
+
+    CoreUART::init();
+    multicore_launch_core1(CoreUART::uart_interface);
+
+    WiFi.init();
+    Modem::pico_modem_main();
+}
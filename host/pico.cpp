@@ -0,0 +1,134 @@
+/*
+  pico.cpp - host build stand-ins for the pico-sdk time, multicore and flash functions
+  Stefan Wessels, 2023
+*/
+#include <thread>
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "hardware/flash.h"
+
+static const auto bootTime = std::chrono::steady_clock::now();
+static std::thread core1;
+
+absolute_time_t get_absolute_time()
+{
+    // Never return nil_time, which means "not set"
+    return 1 + std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - bootTime).count();
+}
+
+void sleep_us(uint64_t us)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void sleep_ms(uint32_t ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+/*
+ * Core 1 is a thread.  It can't be stopped from the outside, so reset waits
+ * for it to leave its entry function (the modem sends 'S' on c0cmd first)
+ */
+void multicore_launch_core1(void (*entry)(void))
+{
+    multicore_reset_core1();
+    core1 = std::thread(entry);
+}
+
+void multicore_reset_core1()
+{
+    if (core1.joinable())
+        core1.join();
+}
+
+/*
+ * The flash is mapped from a file, $MODEM_FLASH or modem_flash.bin, so
+ * AT&W survives a restart.  A new file reads as erased (0xff)
+ */
+uint8_t *host_flash_base()
+{
+    static uint8_t *flash = nullptr;
+    if (!flash)
+    {
+        const char *name = getenv("MODEM_FLASH");
+        int fd = open(name ? name : "modem_flash.bin", O_RDWR | O_CREAT, 0644);
+        if (fd >= 0)
+        {
+            off_t size = lseek(fd, 0, SEEK_END);
+            if (size >= PICO_FLASH_SIZE_BYTES || (size >= 0 && !ftruncate(fd, PICO_FLASH_SIZE_BYTES)))
+            {
+                void *map = mmap(nullptr, PICO_FLASH_SIZE_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if (map != MAP_FAILED)
+                {
+                    flash = (uint8_t *)map;
+                    if (size < PICO_FLASH_SIZE_BYTES)
+                        memset(flash + size, 0xff, PICO_FLASH_SIZE_BYTES - size);
+                }
+            }
+            close(fd);
+        }
+        if (!flash)
+        {
+            // No file - keep the settings in memory for this run
+            flash = (uint8_t *)malloc(PICO_FLASH_SIZE_BYTES);
+            memset(flash, 0xff, PICO_FLASH_SIZE_BYTES);
+        }
+    }
+    return flash;
+}
+
+void flash_range_erase(uint32_t flash_offs, size_t count)
+{
+    if (flash_offs + count <= PICO_FLASH_SIZE_BYTES)
+        memset(host_flash_base() + flash_offs, 0xff, count);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count)
+{
+    if (flash_offs + count <= PICO_FLASH_SIZE_BYTES)
+    {
+        // Like the real flash, programming can only clear bits
+        uint8_t *flash = host_flash_base() + flash_offs;
+        for (size_t i = 0; i < count; i++)
+            flash[i] &= data[i];
+        msync(host_flash_base(), PICO_FLASH_SIZE_BYTES, MS_ASYNC);
+    }
+}
+
+static char *convert(unsigned long value, char *string, int radix, bool negative)
+{
+    char tmp[33];
+    int i = 0, j = 0;
+    do
+    {
+        int digit = value % radix;
+        tmp[i++] = digit < 10 ? '0' + digit : 'a' + digit - 10;
+        value /= radix;
+    } while (value);
+    if (negative)
+        string[j++] = '-';
+    while (i)
+        string[j++] = tmp[--i];
+    string[j] = '\0';
+    return string;
+}
+
+char *itoa(int value, char *string, int radix)
+{
+    if (value < 0 && radix == 10)
+        return convert(-(long)value, string, radix, true);
+    return convert((unsigned)value, string, radix, false);
+}
+
+char *utoa(unsigned value, char *string, int radix)
+{
+    return convert(value, string, radix, false);
+}
@@ -0,0 +1,113 @@
+/*
+  ring_stress.cpp - runs RingBuffer with a producer and a consumer thread, the
+  way core 0 and core 1 share it, through write_span/commit and
+  read_span/consume.  The stream is a count of 32 bit sequence numbers, and
+  every byte the consumer sees is checked against the one that belongs at
+  that place, so a lost, doubled or stale byte, or one seen before it was
+  published, is caught.  Spans are filled and drained in odd amounts so the
+  wrap is crossed at every offset
+    ring_stress [megabytes]
+  Stefan Wessels, 2023
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+#include <thread>
+
+#include "RingBuf.h"
+
+#define QUEUE_SIZE  1024    // Modem.cpp's CORE_QUEUE_SIZE
+#define DEFAULT_MB  64
+
+// The byte at pos in the stream: sequence number pos / 4, little endian
+static inline uint8_t streamByte(uint64_t pos)
+{
+    return (uint8_t)((pos >> 2) >> ((pos & 3) * 8));
+}
+
+// A small, cheap, changing amount to move at a time, from 1 to 1024
+static inline size_t chunk(uint32_t *seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return 1 + ((*seed >> 16) & (QUEUE_SIZE - 1));
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t total = (uint64_t)(argc > 1 ? atoi(argv[1]) : DEFAULT_MB) << 20;
+    RingBuffer ring(QUEUE_SIZE);
+    uint64_t badAt = UINT64_MAX;
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread producer([&]
+    {
+        uint32_t seed = 1;
+        uint64_t pos = 0;
+        while (pos < total)
+        {
+            uint8_t *span;
+            size_t len = ring.write_span(&span);
+            if (!len)
+            {
+                // Where a core would WFE, let the other thread run
+                std::this_thread::yield();
+                continue;
+            }
+            size_t want = chunk(&seed);
+            if (len > want)
+                len = want;
+            if (len > total - pos)
+                len = total - pos;
+            for (size_t i = 0; i < len; i++)
+                span[i] = streamByte(pos++);
+            ring.commit(len);
+        }
+    });
+
+    std::thread consumer([&]
+    {
+        uint32_t seed = 2;
+        uint64_t pos = 0;
+        // After a bad byte, carry on draining so the producer can finish
+        while (pos < total)
+        {
+            const uint8_t *span;
+            size_t len = ring.read_span(&span);
+            if (!len)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            size_t want = chunk(&seed);
+            if (len > want)
+                len = want;
+            for (size_t i = 0; i < len && badAt == UINT64_MAX; i++)
+            {
+                if (span[i] != streamByte(pos + i))
+                    badAt = pos + i;
+            }
+            ring.consume(len);
+            pos += len;
+        }
+    });
+
+    producer.join();
+    consumer.join();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (badAt != UINT64_MAX)
+    {
+        printf("FAIL: sequence %llu byte %d is wrong\n", (unsigned long long)(badAt >> 2), (int)(badAt & 3));
+        return 1;
+    }
+    if (ring.readable())
+    {
+        printf("FAIL: %d bytes left over\n", (int)ring.readable());
+        return 1;
+    }
+    printf("PASS: %llu bytes, %llu sequence numbers, in %.3fs, %.0f bytes/sec\n",
+           (unsigned long long)total, (unsigned long long)(total >> 2), secs, total / secs);
+    return 0;
+}
@@ -0,0 +1,12 @@
+/*
+  FreeRTOS.h - host build stand-in
+  There is no scheduler on the host, so critical sections are empty
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_FREERTOS_H
+#define _HOST_FREERTOS_H
+
+static inline void vPortEnterCritical() { ; }
+static inline void vPortExitCritical() { ; }
+
+#endif // _HOST_FREERTOS_H
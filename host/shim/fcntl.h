@@ -0,0 +1,17 @@
+/*
+  fcntl.h - host build wrapper for the C library header
+  glibc's fcntl.h also defines access() modes such as R_OK, which newlib's does
+  not and which collide with the modem's result codes
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_FCNTL_H
+#define _HOST_FCNTL_H
+
+#include_next <fcntl.h>
+
+#undef R_OK
+#undef W_OK
+#undef X_OK
+#undef F_OK
+
+#endif // _HOST_FCNTL_H
@@ -0,0 +1,82 @@
+/*
+  ff.h - host build stand-in for FatFs
+  Volume "0:" is the folder $MODEM_SD_ROOT (or ./sd)
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_FF_H
+#define _HOST_FF_H
+
+#include <stdint.h>
+
+#define FF_USE_FASTSEEK 1
+#define FF_USE_EXPAND   1
+
+typedef unsigned int UINT;
+typedef uint8_t BYTE;
+typedef uint16_t WORD;
+typedef uint32_t DWORD;
+typedef uint64_t FSIZE_t;
+typedef char TCHAR;
+
+typedef enum
+{
+    FR_OK = 0,
+    FR_DISK_ERR,
+    FR_INT_ERR,
+    FR_NOT_READY,
+    FR_NO_FILE,
+    FR_NO_PATH,
+    FR_INVALID_NAME,
+    FR_DENIED,
+    FR_EXIST,
+    FR_INVALID_OBJECT,
+    FR_WRITE_PROTECTED,
+    FR_INVALID_DRIVE,
+    FR_NOT_ENABLED,
+    FR_NO_FILESYSTEM,
+    FR_MKFS_ABORTED,
+    FR_TIMEOUT,
+    FR_LOCKED,
+    FR_NOT_ENOUGH_CORE,
+    FR_TOO_MANY_OPEN_FILES,
+    FR_INVALID_PARAMETER
+} FRESULT;
+
+#define FA_READ             0x01
+#define FA_WRITE            0x02
+#define FA_OPEN_EXISTING    0x00
+#define FA_CREATE_NEW       0x04
+#define FA_CREATE_ALWAYS    0x08
+#define FA_OPEN_ALWAYS      0x10
+#define FA_OPEN_APPEND      0x30
+
+#define CREATE_LINKMAP      ((FSIZE_t)0 - 1)
+
+typedef struct
+{
+    BYTE fs_type;
+} FATFS;
+
+typedef struct
+{
+    int fd;
+    FSIZE_t fptr;
+    FSIZE_t size;
+    DWORD *cltbl;
+} FIL;
+
+#define f_size(fp)  ((fp)->size)
+#define f_tell(fp)  ((fp)->fptr)
+
+FRESULT f_mount(FATFS *fs, const TCHAR *path, BYTE opt);
+FRESULT f_open(FIL *fp, const TCHAR *path, BYTE mode);
+FRESULT f_close(FIL *fp);
+FRESULT f_read(FIL *fp, void *buff, UINT btr, UINT *br);
+FRESULT f_write(FIL *fp, const void *buff, UINT btw, UINT *bw);
+FRESULT f_lseek(FIL *fp, FSIZE_t ofs);
+FRESULT f_expand(FIL *fp, FSIZE_t fsz, BYTE opt);
+FRESULT f_sync(FIL *fp);
+FRESULT f_mkdir(const TCHAR *path);
+FRESULT f_unlink(const TCHAR *path);
+
+#endif // _HOST_FF_H
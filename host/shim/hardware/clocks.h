@@ -0,0 +1,22 @@
+/*
+  hardware/clocks.h - host build stand-in for the pico-sdk header
+  The clocks run at the pico-sdk defaults
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_HARDWARE_CLOCKS_H
+#define _HOST_HARDWARE_CLOCKS_H
+
+#include "pico/types.h"
+
+enum clock_index
+{
+    clk_sys,
+    clk_peri
+};
+
+static inline uint32_t clock_get_hz(enum clock_index clk_index)
+{
+    return 125000000;
+}
+
+#endif // _HOST_HARDWARE_CLOCKS_H
@@ -0,0 +1,20 @@
+/*
+  hardware/flash.h - host build stand-in for the pico-sdk header
+  The flash is a file mapped into memory, XIP_BASE is where it is mapped
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_HARDWARE_FLASH_H
+#define _HOST_HARDWARE_FLASH_H
+
+#include "pico/types.h"
+
+#define PICO_FLASH_SIZE_BYTES   (2 * 1024 * 1024)
+#define FLASH_PAGE_SIZE         (1u << 8)
+#define FLASH_SECTOR_SIZE       (1u << 12)
+#define XIP_BASE                ((uintptr_t)host_flash_base())
+
+uint8_t *host_flash_base();
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+#endif // _HOST_HARDWARE_FLASH_H
@@ -0,0 +1,12 @@
+/*
+  hardware/sync.h - host build stand-in for the pico-sdk header
+  The host's core 1 thread polls, so there is no one to wake
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_HARDWARE_SYNC_H
+#define _HOST_HARDWARE_SYNC_H
+
+static inline void __sev(void) { ; }
+static inline void __wfe(void) { ; }
+
+#endif // _HOST_HARDWARE_SYNC_H
@@ -0,0 +1,30 @@
+/*
+  lwip/ip4_addr.h - host build stand-in
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_LWIP_IP4_ADDR_H
+#define _HOST_LWIP_IP4_ADDR_H
+
+#include <stdint.h>
+
+typedef uint8_t u8_t;
+typedef uint16_t u16_t;
+typedef uint32_t u32_t;
+typedef int8_t err_t;
+
+typedef struct ip4_addr
+{
+    u32_t addr;
+} ip4_addr_t;
+typedef ip4_addr_t ip_addr_t;
+
+#define ERR_OK      0
+#define ERR_MEM     -1
+#define ERR_VAL     -6
+#define ERR_ARG     -16
+
+#define IPADDR4_INIT(u32val)    (u32val)
+#define IP4_ADDR(ipaddr, a, b, c, d) \
+    (ipaddr)->addr = ((u32_t)((d) & 0xff) << 24) | ((u32_t)((c) & 0xff) << 16) | ((u32_t)((b) & 0xff) << 8) | (u32_t)((a) & 0xff)
+
+#endif // _HOST_LWIP_IP4_ADDR_H
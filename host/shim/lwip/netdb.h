@@ -0,0 +1,10 @@
+/*
+  lwip/netdb.h - host build stand-in
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_LWIP_NETDB_H
+#define _HOST_LWIP_NETDB_H
+
+#include <netdb.h>
+
+#endif // _HOST_LWIP_NETDB_H
@@ -0,0 +1,10 @@
+/*
+  lwip/netif.h - host build stand-in
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_LWIP_NETIF_H
+#define _HOST_LWIP_NETIF_H
+
+#include "lwip/ip4_addr.h"
+
+#endif // _HOST_LWIP_NETIF_H
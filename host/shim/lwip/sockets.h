@@ -0,0 +1,25 @@
+/*
+  lwip/sockets.h - host build stand-in
+  lwIP's socket API is the BSD one, so the host's own sockets are used
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_LWIP_SOCKETS_H
+#define _HOST_LWIP_SOCKETS_H
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+// lwIP does not pull in unistd.h's access() modes, and R_OK is a modem result code
+#undef R_OK
+#undef W_OK
+#undef X_OK
+#undef F_OK
+
+#endif // _HOST_LWIP_SOCKETS_H
@@ -0,0 +1,44 @@
+/*
+  lwip/udp.h - host build stand-in for the raw UDP API used by NTPClient
+  Nothing goes on the network - udp_send answers with the host clock as if
+  an NTP server had replied
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_LWIP_UDP_H
+#define _HOST_LWIP_UDP_H
+
+#include "lwip/ip4_addr.h"
+
+struct pbuf
+{
+    void *payload;
+    u16_t len;
+    u16_t tot_len;
+};
+
+struct udp_pcb;
+typedef void (*udp_recv_fn)(void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *addr, u16_t port);
+
+struct udp_pcb
+{
+    udp_recv_fn recv;
+    void *recv_arg;
+};
+
+typedef enum { PBUF_TRANSPORT } pbuf_layer;
+typedef enum { PBUF_POOL, PBUF_RAM } pbuf_type;
+
+extern const ip_addr_t ip_addr_any;
+#define IP4_ADDR_ANY (&ip_addr_any)
+
+struct udp_pcb *udp_new();
+void udp_remove(struct udp_pcb *pcb);
+err_t udp_bind(struct udp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port);
+err_t udp_connect(struct udp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port);
+void udp_disconnect(struct udp_pcb *pcb);
+void udp_recv(struct udp_pcb *pcb, udp_recv_fn recv, void *recv_arg);
+err_t udp_send(struct udp_pcb *pcb, struct pbuf *p);
+struct pbuf *pbuf_alloc(pbuf_layer layer, u16_t length, pbuf_type type);
+u8_t pbuf_free(struct pbuf *p);
+
+#endif // _HOST_LWIP_UDP_H
@@ -0,0 +1,42 @@
+/*
+  pico/cyw43_arch.h - host build stand-in for the pico-sdk header
+  Only what the modem code touches - the WiFi chip is not simulated
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_PICO_CYW43_ARCH_H
+#define _HOST_PICO_CYW43_ARCH_H
+
+#include "pico/types.h"
+
+#define CYW43_LINK_DOWN         (0)
+#define CYW43_LINK_JOIN         (1)
+#define CYW43_LINK_NOIP         (2)
+#define CYW43_LINK_UP           (3)
+#define CYW43_LINK_FAIL         (-1)
+#define CYW43_LINK_NONET        (-2)
+#define CYW43_LINK_BADAUTH      (-3)
+
+#define CYW43_ITF_STA           0
+#define CYW43_WL_GPIO_LED_PIN   0
+
+#define CYW43_AUTH_OPEN             (0)
+#define CYW43_AUTH_WPA_TKIP_PSK     (0x00200002)
+#define CYW43_AUTH_WPA2_AES_PSK     (0x00400004)
+
+typedef struct _cyw43_ev_scan_result_t
+{
+    uint32_t _0[5];
+    uint8_t bssid[6];
+    uint16_t _1[2];
+    uint8_t ssid_len;
+    uint8_t ssid[32];
+    uint32_t _2[5];
+    uint16_t channel;
+    uint16_t _3;
+    uint8_t auth_mode;
+    int16_t rssi;
+} cyw43_ev_scan_result_t;
+
+static inline void cyw43_arch_gpio_put(uint wl_gpio, bool value) { (void)wl_gpio; (void)value; }
+
+#endif // _HOST_PICO_CYW43_ARCH_H
@@ -0,0 +1,12 @@
+/*
+  pico/multicore.h - host build stand-in for the pico-sdk header
+  Core 1 is a pthread on the host
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_PICO_MULTICORE_H
+#define _HOST_PICO_MULTICORE_H
+
+void multicore_launch_core1(void (*entry)(void));
+void multicore_reset_core1();
+
+#endif // _HOST_PICO_MULTICORE_H
@@ -0,0 +1,17 @@
+/*
+  pico/stdlib.h - host build stand-in for the pico-sdk header
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_PICO_STDLIB_H
+#define _HOST_PICO_STDLIB_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "pico/types.h"
+#include "pico/time.h"
+
+// newlib extensions that the firmware relies on and glibc does not have
+char *itoa(int value, char *string, int radix);
+char *utoa(unsigned value, char *string, int radix);
+
+#endif // _HOST_PICO_STDLIB_H
@@ -0,0 +1,26 @@
+/*
+  pico/time.h - host build stand-in for the pico-sdk header
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_PICO_TIME_H
+#define _HOST_PICO_TIME_H
+
+#include "pico/types.h"
+
+#define nil_time ((absolute_time_t)0)
+
+absolute_time_t get_absolute_time();
+void sleep_ms(uint32_t ms);
+void sleep_us(uint64_t us);
+
+static inline bool is_nil_time(absolute_time_t t) { return t == nil_time; }
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) { return (int64_t)(to - from); }
+static inline uint32_t us_to_ms(uint64_t us) { return (uint32_t)(us / 1000); }
+static inline uint32_t to_ms_since_boot(absolute_time_t t) { return us_to_ms(t); }
+static inline absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us) { return t + us; }
+static inline absolute_time_t delayed_by_ms(absolute_time_t t, uint32_t ms) { return t + (uint64_t)ms * 1000; }
+static inline absolute_time_t make_timeout_time_us(uint64_t us) { return delayed_by_us(get_absolute_time(), us); }
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) { return delayed_by_ms(get_absolute_time(), ms); }
+static inline bool time_reached(absolute_time_t t) { return get_absolute_time() >= t; }
+
+#endif // _HOST_PICO_TIME_H
@@ -0,0 +1,20 @@
+/*
+  pico/types.h - host build stand-in for the pico-sdk header
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_PICO_TYPES_H
+#define _HOST_PICO_TYPES_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;   // Microseconds since the host build started
+
+#ifndef __unused
+#define __unused __attribute__((unused))
+#endif
+#define __time_critical_func(x) x
+
+#endif // _HOST_PICO_TYPES_H
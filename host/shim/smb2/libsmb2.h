@@ -0,0 +1,62 @@
+/*
+  smb2/libsmb2.h - host build stand-in for libsmb2
+  smb://server/share/path is served from $MODEM_SMB_ROOT/share/path
+  (or ./share/path), so no SMB server is needed on the host
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_LIBSMB2_H
+#define _HOST_LIBSMB2_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "smb2/smb2.h"
+
+struct smb2_context;
+struct smb2fh;
+
+struct smb2_url
+{
+    const char *domain;
+    const char *user;
+    const char *server;
+    const char *share;
+    const char *path;
+};
+
+struct smb2dirent
+{
+    const char *name;
+    struct smb2_stat_64 st;
+};
+
+// Async calls complete from smb2_service(), status is a byte count or -errno
+typedef void (*smb2_command_cb)(struct smb2_context *smb2, int status, void *command_data, void *cb_data);
+
+struct smb2_context *smb2_init_context(void);
+void smb2_destroy_context(struct smb2_context *smb2);
+const char *smb2_get_error(struct smb2_context *smb2);
+void smb2_set_security_mode(struct smb2_context *smb2, uint16_t security_mode);
+
+struct smb2_url *smb2_parse_url(struct smb2_context *smb2, const char *url);
+void smb2_destroy_url(struct smb2_url *url);
+
+int smb2_connect_share(struct smb2_context *smb2, const char *server, const char *share, const char *user);
+int smb2_connect_share_async(struct smb2_context *smb2, const char *server, const char *share, const char *user, smb2_command_cb cb, void *cb_data);
+int smb2_disconnect_share(struct smb2_context *smb2);
+
+struct smb2fh *smb2_open(struct smb2_context *smb2, const char *path, int flags);
+int smb2_open_async(struct smb2_context *smb2, const char *path, int flags, smb2_command_cb cb, void *cb_data);
+int smb2_close(struct smb2_context *smb2, struct smb2fh *fh);
+int smb2_fstat(struct smb2_context *smb2, struct smb2fh *fh, struct smb2_stat_64 *st);
+int smb2_fstat_async(struct smb2_context *smb2, struct smb2fh *fh, struct smb2_stat_64 *st, smb2_command_cb cb, void *cb_data);
+int smb2_pread(struct smb2_context *smb2, struct smb2fh *fh, uint8_t *buf, uint32_t count, uint64_t offset);
+int smb2_pread_async(struct smb2_context *smb2, struct smb2fh *fh, uint8_t *buf, uint32_t count, uint64_t offset, smb2_command_cb cb, void *cb_data);
+int smb2_pwrite(struct smb2_context *smb2, struct smb2fh *fh, const uint8_t *buf, uint32_t count, uint64_t offset);
+int smb2_pwrite_async(struct smb2_context *smb2, struct smb2fh *fh, const uint8_t *buf, uint32_t count, uint64_t offset, smb2_command_cb cb, void *cb_data);
+
+// There is no socket - smb2_service() completes all queued async calls
+int smb2_get_fd(struct smb2_context *smb2);
+int smb2_which_events(struct smb2_context *smb2);
+int smb2_service(struct smb2_context *smb2, int revents);
+
+#endif // _HOST_LIBSMB2_H
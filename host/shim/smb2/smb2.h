@@ -0,0 +1,38 @@
+/*
+  smb2/smb2.h - host build stand-in for libsmb2
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_SMB2_H
+#define _HOST_SMB2_H
+
+#include <stdint.h>
+
+#define SMB2_NEGOTIATE_SIGNING_ENABLED  0x0001
+#define SMB2_NEGOTIATE_SIGNING_REQUIRED 0x0002
+
+#define SMB2_TYPE_FILE      0x00000000
+#define SMB2_TYPE_DIRECTORY 0x00000001
+
+struct smb2_timeval
+{
+    uint32_t tv_sec;
+    uint32_t tv_usec;
+};
+
+struct smb2_stat_64
+{
+    uint32_t smb2_type;
+    uint32_t smb2_nlink;
+    uint64_t smb2_ino;
+    uint64_t smb2_size;
+    uint64_t smb2_atime;
+    uint64_t smb2_atime_nsec;
+    uint64_t smb2_mtime;
+    uint64_t smb2_mtime_nsec;
+    uint64_t smb2_ctime;
+    uint64_t smb2_ctime_nsec;
+    uint64_t smb2_btime;
+    uint64_t smb2_btime_nsec;
+};
+
+#endif // _HOST_SMB2_H
@@ -0,0 +1,10 @@
+/*
+  task.h - host build stand-in
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_TASK_H
+#define _HOST_TASK_H
+
+#include "FreeRTOS.h"
+
+#endif // _HOST_TASK_H
@@ -0,0 +1,110 @@
+/*
+  wolfssh/ssh.h - host build stand-in for wolfSSH
+  SSH is not available in the host build - creating a context fails, so
+  ATDSSH answers NO ANSWER
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_WOLFSSH_SSH_H
+#define _HOST_WOLFSSH_SSH_H
+
+#include <stdint.h>
+#include <string.h>
+
+typedef uint8_t byte;
+typedef uint32_t word32;
+
+typedef struct WOLFSSH_CTX WOLFSSH_CTX;
+typedef struct WOLFSSH WOLFSSH;
+
+#define WMEMSET(d, v, l)    memset((d), (v), (l))
+
+enum WS_ErrorCodes
+{
+    WS_SUCCESS = 0,
+    WS_FATAL_ERROR = -1001,
+    WS_EOF = -1008,
+    WS_EXTDATA = -1048,
+    WS_WANT_READ = -1030,
+    WS_WANT_WRITE = -1031
+};
+
+enum WS_EndpointTypes
+{
+    WOLFSSH_ENDPOINT_SERVER,
+    WOLFSSH_ENDPOINT_CLIENT
+};
+
+enum WS_SessionType
+{
+    WOLFSSH_SESSION_UNKNOWN = 0,
+    WOLFSSH_SESSION_SHELL,
+    WOLFSSH_SESSION_EXEC,
+    WOLFSSH_SESSION_SUBSYSTEM,
+    WOLFSSH_SESSION_TERMINAL
+};
+
+#define WOLFSSH_USERAUTH_PASSWORD   0x01
+#define WOLFSSH_USERAUTH_PUBLICKEY  0x02
+
+enum WS_UserAuthResults
+{
+    WOLFSSH_USERAUTH_SUCCESS,
+    WOLFSSH_USERAUTH_FAILURE,
+    WOLFSSH_USERAUTH_INVALID_USER,
+    WOLFSSH_USERAUTH_INVALID_PASSWORD,
+    WOLFSSH_USERAUTH_INVALID_PUBLICKEY
+};
+
+typedef struct WS_UserAuthData_Password
+{
+    const byte *password;
+    word32 passwordSz;
+} WS_UserAuthData_Password;
+
+typedef struct WS_UserAuthData_PublicKey
+{
+    const byte *publicKeyType;
+    word32 publicKeyTypeSz;
+    const byte *publicKey;
+    word32 publicKeySz;
+    const byte *privateKey;
+    word32 privateKeySz;
+} WS_UserAuthData_PublicKey;
+
+typedef struct WS_UserAuthData
+{
+    byte type;
+    const byte *username;
+    word32 usernameSz;
+    union
+    {
+        WS_UserAuthData_Password password;
+        WS_UserAuthData_PublicKey publicKey;
+    } sf;
+} WS_UserAuthData;
+
+typedef int (*WS_CallbackUserAuth)(byte, WS_UserAuthData *, void *);
+typedef int (*WS_CallbackPublicKeyCheck)(const byte *, word32, void *);
+
+static inline int wolfSSH_Init(void) { return WS_SUCCESS; }
+static inline int wolfSSH_Cleanup(void) { return WS_SUCCESS; }
+static inline WOLFSSH_CTX *wolfSSH_CTX_new(byte side, void *heap) { (void)side; (void)heap; return NULL; }
+static inline void wolfSSH_CTX_free(WOLFSSH_CTX *ctx) { (void)ctx; }
+static inline void wolfSSH_SetUserAuth(WOLFSSH_CTX *ctx, WS_CallbackUserAuth cb) { (void)ctx; (void)cb; }
+static inline int wolfSSH_CTX_SetWindowPacketSize(WOLFSSH_CTX *ctx, word32 windowSz, word32 maxPacketSz) { (void)ctx; (void)windowSz; (void)maxPacketSz; return WS_SUCCESS; }
+static inline void wolfSSH_CTX_SetPublicKeyCheck(WOLFSSH_CTX *ctx, WS_CallbackPublicKeyCheck cb) { (void)ctx; (void)cb; }
+static inline WOLFSSH *wolfSSH_new(WOLFSSH_CTX *ctx) { (void)ctx; return NULL; }
+static inline void wolfSSH_free(WOLFSSH *ssh) { (void)ssh; }
+static inline void wolfSSH_SetUserAuthCtx(WOLFSSH *ssh, void *ctx) { (void)ssh; (void)ctx; }
+static inline void wolfSSH_SetPublicKeyCheckCtx(WOLFSSH *ssh, void *ctx) { (void)ssh; (void)ctx; }
+static inline int wolfSSH_SetUsername(WOLFSSH *ssh, const char *username) { (void)ssh; (void)username; return WS_FATAL_ERROR; }
+static inline int wolfSSH_set_fd(WOLFSSH *ssh, int fd) { (void)ssh; (void)fd; return WS_FATAL_ERROR; }
+static inline int wolfSSH_SetChannelType(WOLFSSH *ssh, byte type, byte *name, word32 nameSz) { (void)ssh; (void)type; (void)name; (void)nameSz; return WS_FATAL_ERROR; }
+static inline int wolfSSH_connect(WOLFSSH *ssh) { (void)ssh; return WS_FATAL_ERROR; }
+static inline int wolfSSH_get_error(const WOLFSSH *ssh) { (void)ssh; return WS_FATAL_ERROR; }
+static inline int wolfSSH_stream_send(WOLFSSH *ssh, byte *buf, word32 bufSz) { (void)ssh; (void)buf; (void)bufSz; return WS_FATAL_ERROR; }
+static inline int wolfSSH_stream_read(WOLFSSH *ssh, byte *buf, word32 bufSz) { (void)ssh; (void)buf; (void)bufSz; return WS_FATAL_ERROR; }
+static inline int wolfSSH_stream_peek(WOLFSSH *ssh, byte *buf, word32 bufSz) { (void)ssh; (void)buf; (void)bufSz; return 0; }
+static inline int wolfSSH_extended_data_read(WOLFSSH *ssh, byte *buf, word32 bufSz) { (void)ssh; (void)buf; (void)bufSz; return WS_FATAL_ERROR; }
+
+#endif // _HOST_WOLFSSH_SSH_H
@@ -0,0 +1,63 @@
+/*
+  wolfssl/ssl.h - host build stand-in for wolfSSL
+  TLS is not available in the host build - creating a context fails, so
+  ATDTLS answers NO ANSWER and https ATGET answers NO CARRIER
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_WOLFSSL_SSL_H
+#define _HOST_WOLFSSL_SSL_H
+
+#include "wolfcrypt/types.h"
+
+typedef uint16_t word16;
+
+typedef struct WOLFSSL_CTX WOLFSSL_CTX;
+typedef struct WOLFSSL WOLFSSL;
+typedef struct WOLFSSL_SESSION WOLFSSL_SESSION;
+typedef struct WOLFSSL_METHOD WOLFSSL_METHOD;
+
+#define WOLFSSL_SUCCESS             1
+#define WOLFSSL_FILETYPE_ASN1       2
+#define WOLFSSL_VERIFY_PEER         1
+#define WOLFSSL_SNI_HOST_NAME       0
+#define WOLFSSL_ERROR_WANT_READ     2
+#define WOLFSSL_ERROR_WANT_WRITE    3
+
+enum IOerrors
+{
+    WOLFSSL_CBIO_ERR_GENERAL = -1,
+    WOLFSSL_CBIO_ERR_WANT_READ = -2,
+    WOLFSSL_CBIO_ERR_CONN_CLOSE = -5
+};
+
+typedef int (*CallbackIORecv)(WOLFSSL *ssl, char *buf, int sz, void *ctx);
+typedef int (*CallbackIOSend)(WOLFSSL *ssl, char *buf, int sz, void *ctx);
+typedef int (*VerifyCallback)(int, void *);
+
+static inline int wolfSSL_Init(void) { return WOLFSSL_SUCCESS; }
+static inline WOLFSSL_METHOD *wolfSSLv23_client_method(void) { return NULL; }
+static inline WOLFSSL_CTX *wolfSSL_CTX_new(WOLFSSL_METHOD *method) { (void)method; return NULL; }
+static inline int wolfSSL_CTX_load_verify_buffer(WOLFSSL_CTX *ctx, const unsigned char *in, long sz, int format) { (void)ctx; (void)in; (void)sz; (void)format; return -1; }
+static inline void wolfSSL_CTX_set_verify(WOLFSSL_CTX *ctx, int mode, VerifyCallback vc) { (void)ctx; (void)mode; (void)vc; }
+static inline int wolfSSL_CTX_UseSessionTicket(WOLFSSL_CTX *ctx) { (void)ctx; return WOLFSSL_SUCCESS; }
+static inline void wolfSSL_CTX_SetIORecv(WOLFSSL_CTX *ctx, CallbackIORecv cb) { (void)ctx; (void)cb; }
+static inline void wolfSSL_CTX_SetIOSend(WOLFSSL_CTX *ctx, CallbackIOSend cb) { (void)ctx; (void)cb; }
+static inline WOLFSSL *wolfSSL_new(WOLFSSL_CTX *ctx) { (void)ctx; return NULL; }
+static inline void wolfSSL_free(WOLFSSL *ssl) { (void)ssl; }
+static inline void wolfSSL_SetIOReadCtx(WOLFSSL *ssl, void *ctx) { (void)ssl; (void)ctx; }
+static inline void wolfSSL_SetIOWriteCtx(WOLFSSL *ssl, void *ctx) { (void)ssl; (void)ctx; }
+static inline int wolfSSL_UseSNI(WOLFSSL *ssl, byte type, const void *data, word16 size) { (void)ssl; (void)type; (void)data; (void)size; return WOLFSSL_SUCCESS; }
+static inline int wolfSSL_check_domain_name(WOLFSSL *ssl, const char *dn) { (void)ssl; (void)dn; return WOLFSSL_SUCCESS; }
+static inline int wolfSSL_set_session(WOLFSSL *ssl, WOLFSSL_SESSION *session) { (void)ssl; (void)session; return -1; }
+static inline WOLFSSL_SESSION *wolfSSL_get1_session(WOLFSSL *ssl) { (void)ssl; return NULL; }
+static inline void wolfSSL_SESSION_free(WOLFSSL_SESSION *session) { (void)session; }
+static inline int wolfSSL_session_reused(WOLFSSL *ssl) { (void)ssl; return 0; }
+static inline int wolfSSL_connect(WOLFSSL *ssl) { (void)ssl; return -1; }
+static inline int wolfSSL_shutdown(WOLFSSL *ssl) { (void)ssl; return -1; }
+static inline int wolfSSL_read(WOLFSSL *ssl, void *data, int sz) { (void)ssl; (void)data; (void)sz; return -1; }
+static inline int wolfSSL_peek(WOLFSSL *ssl, void *data, int sz) { (void)ssl; (void)data; (void)sz; return -1; }
+static inline int wolfSSL_write(WOLFSSL *ssl, const void *data, int sz) { (void)ssl; (void)data; (void)sz; return -1; }
+static inline int wolfSSL_pending(WOLFSSL *ssl) { (void)ssl; return 0; }
+static inline int wolfSSL_get_error(WOLFSSL *ssl, int ret) { (void)ssl; (void)ret; return -1; }
+
+#endif // _HOST_WOLFSSL_SSL_H
@@ -0,0 +1,28 @@
+/*
+  wolfssl/wolfcrypt/ecc.h - host build stand-in for wolfCrypt's ECC
+  Only the SSH user key uses it, and every call fails, so a key in the
+  settings is never loaded in the host build
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_WOLFSSL_ECC_H
+#define _HOST_WOLFSSL_ECC_H
+
+#include "types.h"
+#include "random.h"
+
+enum { ECC_SECP256R1 = 7 };
+
+typedef struct ecc_key { int unused; } ecc_key;
+typedef struct ecc_point ecc_point;
+
+static inline int wc_ecc_init(ecc_key *key) { (void)key; return -1; }
+static inline int wc_ecc_free(ecc_key *key) { (void)key; return 0; }
+static inline ecc_key *wc_ecc_key_new(void *heap) { (void)heap; return NULL; }
+static inline void wc_ecc_key_free(ecc_key *key) { (void)key; }
+static inline int wc_ecc_make_key_ex(WC_RNG *rng, int keysize, ecc_key *key, int curve_id) { (void)rng; (void)keysize; (void)key; (void)curve_id; return -1; }
+static inline int wc_ecc_make_pub(ecc_key *key, ecc_point *pubOut) { (void)key; (void)pubOut; return -1; }
+static inline int wc_ecc_export_private_only(ecc_key *key, byte *out, word32 *outLen) { (void)key; (void)out; (void)outLen; return -1; }
+static inline int wc_ecc_export_x963(ecc_key *key, byte *out, word32 *outLen) { (void)key; (void)out; (void)outLen; return -1; }
+static inline int wc_ecc_import_private_key_ex(const byte *priv, word32 privSz, const byte *pub, word32 pubSz, ecc_key *key, int curve_id) { (void)priv; (void)privSz; (void)pub; (void)pubSz; (void)key; (void)curve_id; return -1; }
+
+#endif // _HOST_WOLFSSL_ECC_H
@@ -0,0 +1,18 @@
+/*
+  wolfssl/wolfcrypt/random.h - host build stand-in for wolfCrypt's RNG
+  There is no RNG, so AT$SSHKEYGEN answers ERROR in the host build
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_WOLFSSL_RANDOM_H
+#define _HOST_WOLFSSL_RANDOM_H
+
+#include "types.h"
+
+typedef struct WC_RNG { int unused; } WC_RNG;
+
+static inline int wc_InitRng(WC_RNG *rng) { (void)rng; return -1; }
+static inline int wc_FreeRng(WC_RNG *rng) { (void)rng; return 0; }
+static inline WC_RNG *wc_rng_new(byte *nonce, word32 nonceSz, void *heap) { (void)nonce; (void)nonceSz; (void)heap; return NULL; }
+static inline void wc_rng_free(WC_RNG *rng) { (void)rng; }
+
+#endif // _HOST_WOLFSSL_RANDOM_H
@@ -0,0 +1,13 @@
+/*
+  wolfssl/wolfcrypt/types.h - host build stand-in for wolfCrypt's types
+  Stefan Wessels, 2023
+*/
+#ifndef _HOST_WOLFSSL_TYPES_H
+#define _HOST_WOLFSSL_TYPES_H
+
+#include <stdint.h>
+
+typedef uint8_t byte;
+typedef uint32_t word32;
+
+#endif // _HOST_WOLFSSL_TYPES_H
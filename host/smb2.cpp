@@ -0,0 +1,243 @@
+/*
+  smb2.cpp - host build stand-in for libsmb2
+  smb://[user@]server/share/path maps to $MODEM_SMB_ROOT/share/path
+  Stefan Wessels, 2023
+*/
+#include <errno.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "smb2/libsmb2.h"
+
+// An async call, carried out when smb2_service() is next called.  It returns
+// the status for the callback and may set its command_data
+struct smb2_async
+{
+    std::function<int(void **)> call;
+    smb2_command_cb cb;
+    void *cb_data;
+};
+
+struct smb2_context
+{
+    std::string share;
+    std::string error;
+    std::vector<smb2_async> queued;
+};
+
+struct smb2fh
+{
+    int fd;
+};
+
+struct smb2_context *smb2_init_context(void)
+{
+    return new smb2_context;
+}
+
+void smb2_destroy_context(struct smb2_context *smb2)
+{
+    delete smb2;
+}
+
+const char *smb2_get_error(struct smb2_context *smb2)
+{
+    return smb2 ? smb2->error.c_str() : "";
+}
+
+void smb2_set_security_mode(struct smb2_context *smb2, uint16_t security_mode)
+{
+}
+
+struct smb2_url *smb2_parse_url(struct smb2_context *smb2, const char *url)
+{
+    if (strncmp(url, "smb://", 6))
+    {
+        smb2->error = "URL does not start with smb://";
+        return NULL;
+    }
+
+    // One allocation holds the url and a copy of the text its fields point into
+    size_t len = strlen(url + 6) + 1;
+    struct smb2_url *u = (struct smb2_url *)calloc(1, sizeof(struct smb2_url) + len + 1);
+    char *str = (char *)(u + 1);
+    memcpy(str, url + 6, len);
+
+    char *at = strchr(str, '@');
+    char *slash = strchr(str, '/');
+    if (at && (!slash || at < slash))
+    {
+        *at = '\0';
+        u->user = str;
+        str = at + 1;
+    }
+    u->server = str;
+    if (!slash)
+    {
+        smb2->error = "URL has no share";
+        free(u);
+        return NULL;
+    }
+    *slash = '\0';
+    u->share = slash + 1;
+    slash = strchr(slash + 1, '/');
+    if (slash)
+    {
+        *slash = '\0';
+        u->path = slash + 1;
+    }
+    else
+    {
+        u->path = "";
+    }
+    return u;
+}
+
+void smb2_destroy_url(struct smb2_url *url)
+{
+    free(url);
+}
+
+int smb2_connect_share(struct smb2_context *smb2, const char *server, const char *share, const char *user)
+{
+    const char *root = getenv("MODEM_SMB_ROOT");
+    struct stat st;
+
+    smb2->share = std::string(root ? root : ".") + "/" + share;
+    if (stat(smb2->share.c_str(), &st) || !S_ISDIR(st.st_mode))
+    {
+        smb2->error = "No such share " + smb2->share;
+        return -ENOENT;
+    }
+    return 0;
+}
+
+int smb2_disconnect_share(struct smb2_context *smb2)
+{
+    if (smb2)
+        smb2->share.clear();
+    return 0;
+}
+
+struct smb2fh *smb2_open(struct smb2_context *smb2, const char *path, int flags)
+{
+    std::string name = smb2->share + "/" + path;
+    int fd = open(name.c_str(), flags, 0644);
+    if (fd < 0)
+    {
+        smb2->error = "Could not open " + name;
+        return NULL;
+    }
+    struct smb2fh *fh = new smb2fh;
+    fh->fd = fd;
+    return fh;
+}
+
+int smb2_close(struct smb2_context *smb2, struct smb2fh *fh)
+{
+    if (!fh)
+        return -EINVAL;
+    close(fh->fd);
+    delete fh;
+    return 0;
+}
+
+int smb2_fstat(struct smb2_context *smb2, struct smb2fh *fh, struct smb2_stat_64 *st)
+{
+    struct stat s;
+    if (fstat(fh->fd, &s))
+        return -errno;
+    memset(st, 0, sizeof(*st));
+    st->smb2_type = S_ISDIR(s.st_mode) ? SMB2_TYPE_DIRECTORY : SMB2_TYPE_FILE;
+    st->smb2_nlink = s.st_nlink;
+    st->smb2_ino = s.st_ino;
+    st->smb2_size = s.st_size;
+    st->smb2_mtime = s.st_mtime;
+    return 0;
+}
+
+int smb2_pread(struct smb2_context *smb2, struct smb2fh *fh, uint8_t *buf, uint32_t count, uint64_t offset)
+{
+    ssize_t ret = pread(fh->fd, buf, count, offset);
+    return ret < 0 ? -errno : (int)ret;
+}
+
+int smb2_pwrite(struct smb2_context *smb2, struct smb2fh *fh, const uint8_t *buf, uint32_t count, uint64_t offset)
+{
+    ssize_t ret = pwrite(fh->fd, buf, count, offset);
+    return ret < 0 ? -errno : (int)ret;
+}
+
+int smb2_connect_share_async(struct smb2_context *smb2, const char *server, const char *share, const char *user, smb2_command_cb cb, void *cb_data)
+{
+    std::string s = share;
+    smb2->queued.push_back({[=](void **) { return smb2_connect_share(smb2, server, s.c_str(), user); }, cb, cb_data});
+    return 0;
+}
+
+int smb2_open_async(struct smb2_context *smb2, const char *path, int flags, smb2_command_cb cb, void *cb_data)
+{
+    std::string p = path;
+    smb2->queued.push_back({[=](void **data) {
+        struct smb2fh *fh = smb2_open(smb2, p.c_str(), flags);
+        *data = fh;
+        return fh ? 0 : -ENOENT;
+    }, cb, cb_data});
+    return 0;
+}
+
+int smb2_fstat_async(struct smb2_context *smb2, struct smb2fh *fh, struct smb2_stat_64 *st, smb2_command_cb cb, void *cb_data)
+{
+    if (!fh)
+        return -EINVAL;
+    smb2->queued.push_back({[=](void **) { return smb2_fstat(smb2, fh, st); }, cb, cb_data});
+    return 0;
+}
+
+int smb2_pread_async(struct smb2_context *smb2, struct smb2fh *fh, uint8_t *buf, uint32_t count, uint64_t offset, smb2_command_cb cb, void *cb_data)
+{
+    if (!fh)
+        return -EINVAL;
+    smb2->queued.push_back({[=](void **) { return smb2_pread(smb2, fh, buf, count, offset); }, cb, cb_data});
+    return 0;
+}
+
+int smb2_pwrite_async(struct smb2_context *smb2, struct smb2fh *fh, const uint8_t *buf, uint32_t count, uint64_t offset, smb2_command_cb cb, void *cb_data)
+{
+    if (!fh)
+        return -EINVAL;
+    smb2->queued.push_back({[=](void **) { return smb2_pwrite(smb2, fh, buf, count, offset); }, cb, cb_data});
+    return 0;
+}
+
+int smb2_get_fd(struct smb2_context *smb2)
+{
+    return -1;
+}
+
+int smb2_which_events(struct smb2_context *smb2)
+{
+    return POLLIN;
+}
+
+int smb2_service(struct smb2_context *smb2, int revents)
+{
+    // Callbacks may queue more work, so take the current list first
+    std::vector<smb2_async> work;
+    work.swap(smb2->queued);
+    for (smb2_async &a : work)
+    {
+        void *data = NULL;
+        int status = a.call(&data);
+        a.cb(smb2, status, data, a.cb_data);
+    }
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+  telnet_test.cpp - feeds Telnet a stream of data mixed with option
+  negotiation, subnegotiation, escaped 0xff and CR NUL, split into two
+  pieces at every byte boundary, into three at every pair of boundaries,
+  and a byte at a time.  Every split must give the same terminal data and
+  the same replies to the host as the stream in one piece, and those must
+  be the ones expected
+    telnet_test
+  Stefan Wessels, 2023
+*/
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+
+#include "Telnet.h"
+
+typedef std::vector<uint8_t> Bytes;
+
+#define T_NOP       0xf1
+#define TTYPE_SEND  1
+#define TTYPE_IS    0
+#define TELOPT_BIG  200     // Past TELNET_OPTIONS, so always refused
+
+/*
+ * Stands in for the connection, keeping what Telnet sends the host
+ */
+class Capture : public Print
+{
+public:
+    Bytes sent;
+
+    virtual size_t Write(uint8_t c)
+    {
+        sent.push_back(c);
+        return 1;
+    }
+};
+
+// From the host
+static const Bytes stream = {
+    'H', 'i',
+    T_IAC, T_DO, TELOPT_TTYPE,
+    T_IAC, T_WILL, TELOPT_ECHO,
+    T_IAC, T_SB, TELOPT_TTYPE, TTYPE_SEND, T_IAC, T_SE,
+    'A', '\r', 0, 'B',
+    T_IAC, T_IAC,
+    'C',
+    T_IAC, T_SB, TELOPT_NAWS, 0, T_IAC, T_IAC, 0, 24, T_IAC, T_SE,
+    T_IAC, T_DO, TELOPT_NAWS,
+    T_IAC, T_WONT, TELOPT_ECHO,
+    T_IAC, T_NOP,
+    'D',
+    T_IAC, T_DO, TELOPT_BIG,
+    T_IAC, T_WILL, TELOPT_TTYPE,
+    '\r', '\n', 'E',
+};
+
+// To the terminal
+static const Bytes data = {'H', 'i', 'A', '\r', 'B', T_IAC, 'C', 'D', '\r', '\n', 'E'};
+
+// To the host
+static const Bytes replies = {
+    T_IAC, T_WILL, TELOPT_TTYPE,
+    T_IAC, T_DO, TELOPT_ECHO,
+    T_IAC, T_SB, TELOPT_TTYPE, TTYPE_IS, 'A', 'N', 'S', 'I', T_IAC, T_SE,
+    T_IAC, T_WILL, TELOPT_NAWS,
+    T_IAC, T_SB, TELOPT_NAWS, 0, 80, 0, 24, T_IAC, T_SE,
+    T_IAC, T_DONT, TELOPT_ECHO,
+    T_IAC, T_WONT, TELOPT_BIG,
+    T_IAC, T_DONT, TELOPT_TTYPE,
+};
+
+static int failures = 0;
+
+/*
+ * Decode stream in the pieces that end at cuts, and check what came out
+ */
+static void check(const std::vector<size_t> &cuts, const char *what)
+{
+    Telnet codec;
+    Capture host;
+    Bytes out;
+    size_t from = 0;
+
+    codec.begin(&host);
+    for (size_t i = 0; i <= cuts.size(); i++)
+    {
+        size_t to = i < cuts.size() ? cuts[i] : stream.size();
+        uint8_t piece[64];
+        size_t len = codec.decode(&stream[from], to - from, piece);
+        out.insert(out.end(), piece, piece + len);
+        from = to;
+    }
+    if (out == data && host.sent == replies)
+        return;
+
+    printf("FAIL: %s, split at", what);
+    for (size_t cut : cuts)
+        printf(" %d", (int)cut);
+    printf(": %s%s\n", out == data ? "" : "data wrong ", host.sent == replies ? "" : "replies wrong");
+    failures++;
+}
+
+int main(void)
+{
+    int before;
+
+    check({}, "in one piece");
+
+    before = failures;
+    for (size_t i = 1; i < stream.size(); i++)
+        check({i}, "two pieces");
+    printf("%s: split in two at every byte\n", failures == before ? "PASS" : "FAIL");
+
+    before = failures;
+    for (size_t i = 1; i < stream.size(); i++)
+    {
+        for (size_t j = i + 1; j < stream.size(); j++)
+            check({i, j}, "three pieces");
+    }
+    printf("%s: split in three at every pair of bytes\n", failures == before ? "PASS" : "FAIL");
+
+    before = failures;
+    std::vector<size_t> every;
+    for (size_t i = 1; i < stream.size(); i++)
+        every.push_back(i);
+    check(every, "a byte at a time");
+    printf("%s: a byte at a time\n", failures == before ? "PASS" : "FAIL");
+
+    // The window size is reported with a 0xff in it doubled
+    {
+        Telnet codec;
+        Capture host;
+        uint8_t doNaws[] = {T_IAC, T_DO, TELOPT_NAWS};
+        uint8_t out[sizeof(doNaws)];
+        Bytes naws = {T_IAC, T_WILL, TELOPT_NAWS, T_IAC, T_SB, TELOPT_NAWS, 0, T_IAC, T_IAC, 0, 24, T_IAC, T_SE};
+
+        codec.begin(&host);
+        codec.setWindowSize(255, 24);
+        bool ok = codec.decode(doNaws, sizeof(doNaws), out) == 0 && host.sent == naws;
+        printf("%s: window size with 0xff\n", ok ? "PASS" : "FAIL");
+        if (!ok)
+            failures++;
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,386 @@
+/*
+  BlockCache.cpp - read-ahead, write-back LRU cache of 512 byte disk image blocks
+  Stefan Wessels, 2023
+*/
+#include <stdlib.h>
+#include <string.h>
+#include "pico/time.h"
+#include "lwip/sockets.h"
+#include <smb2/smb2.h>
+#include <smb2/libsmb2.h>
+#include "BlockCache.h"
+
+#define BLOCK_WAIT_MS   5000    // Longest wait for a read or write back before giving up
+
+bool BlockCache::begin(struct smb2_context *smb2, struct smb2fh *fh, uint32_t headerSize, uint64_t imageSize, bool writable)
+{
+    end();
+    slots = (Slot *)malloc(BLOCK_CACHE_SLOTS * sizeof(Slot));
+    flushBuf = (uint8_t *)malloc(BLOCK_FLUSH_BLOCKS * BLOCK_SIZE);
+    if (!slots || !flushBuf)
+    {
+        end();
+        return false;
+    }
+    for (int i = 0; i < BLOCK_CACHE_SLOTS; i++)
+    {
+        slots[i].cache = this;
+        slots[i].generation = generation;
+        slots[i].state = SLOT_EMPTY;
+        slots[i].lastUse = 0;
+    }
+    this->smb2 = smb2;
+    this->fh = fh;
+    this->headerSize = headerSize;
+    this->writable = writable;
+    lastWrite = get_absolute_time();
+    blocks = imageSize > headerSize ? (uint32_t)((imageSize - headerSize + BLOCK_SIZE - 1) / BLOCK_SIZE) : 0;
+    return true;
+}
+
+void BlockCache::end()
+{
+    flush();
+
+    // The async reads write into the slots, so they have to finish first
+    absolute_time_t timeout = make_timeout_time_ms(BLOCK_WAIT_MS);
+    while (smb2 && pending && !time_reached(timeout))
+        service();
+
+    // Requests given up on can still complete, into these slots and from
+    // flushBuf, so then they are left to them and never used again.  The
+    // new generation has readDone and writeDone drop them
+    if (!pending)
+    {
+        free(slots);
+        free(flushBuf);
+    }
+    slots = nullptr;
+    flushBuf = nullptr;
+    generation++;
+    smb2 = nullptr;
+    fh = nullptr;
+    writable = false;
+    blocks = 0;
+    useCounter = 0;
+    lastBlock = 0;
+    runLength = 0;
+    pending = 0;
+    flushAll = false;
+    flushCount = 0;
+    writeFailed = false;
+}
+
+void BlockCache::readDone(struct smb2_context *smb2, int status, void *command_data, void *private_data)
+{
+    Slot *slot = (Slot *)private_data;
+    // From before the last end(), into slots that are no longer used
+    if (slot->generation != slot->cache->generation)
+        return;
+    if (slot->cache->pending)
+        slot->cache->pending--;
+    if (slot->state != SLOT_PENDING)
+        return;
+
+    if (status <= 0)
+    {
+        slot->state = SLOT_EMPTY;
+        return;
+    }
+    // The last block of an image that is not a whole number of blocks
+    if (status < BLOCK_SIZE)
+        memset(&slot->data[status], 0, BLOCK_SIZE - status);
+    slot->state = SLOT_VALID;
+}
+
+void BlockCache::writeDone(struct smb2_context *smb2, int status, void *command_data, void *private_data)
+{
+    // private_data is the first slot written, which ties the write back to
+    // the slots of one begin()
+    Slot *first = (Slot *)private_data;
+    BlockCache *cache = first->cache;
+    if (first->generation != cache->generation)
+        return;
+    if (cache->pending)
+        cache->pending--;
+
+    bool written = status == cache->flushCount * BLOCK_SIZE;
+    if (!written)
+        cache->writeFailed = true;
+
+    // A slot written to again while this was in flight is DIRTY, and stays so
+    for (int i = 0; i < cache->flushCount; i++)
+    {
+        Slot *slot = cache->flushSlots[i];
+        if (slot->state == SLOT_WRITING)
+            slot->state = written ? SLOT_VALID : SLOT_DIRTY;
+    }
+    cache->flushCount = 0;
+
+    // Do not keep retrying a server that refuses the writes
+    if (!written)
+        cache->flushAll = false;
+}
+
+BlockCache::Slot *BlockCache::find(uint32_t block)
+{
+    if (!slots)
+        return nullptr;
+    for (int i = 0; i < BLOCK_CACHE_SLOTS; i++)
+    {
+        if (slots[i].state != SLOT_EMPTY && slots[i].block == block)
+            return &slots[i];
+    }
+    return nullptr;
+}
+
+/**
+ * An empty slot, else the least recently used valid one.  Slots with a read
+ * in flight, or data not yet written back, are never reused
+ */
+BlockCache::Slot *BlockCache::victim()
+{
+    Slot *lru = nullptr;
+    for (int i = 0; i < BLOCK_CACHE_SLOTS; i++)
+    {
+        if (slots[i].state == SLOT_EMPTY)
+            return &slots[i];
+        if (slots[i].state == SLOT_VALID && (!lru || slots[i].lastUse < lru->lastUse))
+            lru = &slots[i];
+    }
+    return lru;
+}
+
+/**
+ * Start an async read of block into a free slot
+ */
+bool BlockCache::request(uint32_t block)
+{
+    if (!smb2 || block >= blocks)
+        return false;
+
+    Slot *slot = victim();
+    if (!slot)
+        return false;
+
+    slot->block = block;
+    slot->lastUse = ++useCounter;
+    slot->state = SLOT_PENDING;
+    if (smb2_pread_async(smb2, fh, slot->data, BLOCK_SIZE, (uint64_t)block * BLOCK_SIZE + headerSize, readDone, slot) < 0)
+    {
+        slot->state = SLOT_EMPTY;
+        return false;
+    }
+    pending++;
+    return true;
+}
+
+void BlockCache::prefetch(uint32_t block)
+{
+    for (uint32_t next = block + 1; next <= block + BLOCK_READ_AHEAD; next++)
+    {
+        if (!find(next) && !request(next))
+            break;
+    }
+}
+
+/**
+ * Service until the slot is no longer waiting on a read
+ */
+bool BlockCache::waitFor(Slot *slot)
+{
+    absolute_time_t timeout = make_timeout_time_ms(BLOCK_WAIT_MS);
+    while (slot->state == SLOT_PENDING && !time_reached(timeout))
+        service();
+    return slot->state != SLOT_PENDING;
+}
+
+void BlockCache::want(uint32_t block)
+{
+    if (!smb2)
+        return;
+
+    if (block == lastBlock + 1)
+        runLength++;
+    else if (block != lastBlock)
+        runLength = 1;
+    lastBlock = block;
+
+    if (!find(block))
+        request(block);
+
+    // Ask for what comes next now, so those reads overlap this one and the
+    // time it takes to send this block
+    if (runLength >= BLOCK_RUN_LENGTH)
+        prefetch(block);
+}
+
+bool BlockCache::fetch(uint32_t block, uint8_t *dest, bool readAhead)
+{
+    Slot *slot = find(block);
+    if (slot && hasData(slot))
+    {
+        slot->lastUse = ++useCounter;
+        memcpy(dest, slot->data, BLOCK_SIZE);
+        return true;
+    }
+    if (!slot)
+        request(block);
+    if (readAhead)
+        prefetch(block);
+    return false;
+}
+
+bool BlockCache::peek(uint32_t block, uint8_t *dest)
+{
+    Slot *slot = find(block);
+    if (!slot || !hasData(slot))
+        return false;
+    memcpy(dest, slot->data, BLOCK_SIZE);
+    return true;
+}
+
+bool BlockCache::write(uint32_t block, const uint8_t *src)
+{
+    if (!smb2 || !writable || block >= blocks)
+        return false;
+
+    // A read in flight would land on top of the new data
+    Slot *slot = find(block);
+    if (slot && !waitFor(slot))
+        return false;
+
+    if (!slot || slot->state == SLOT_EMPTY)
+    {
+        // With every slot dirty, some have to be written back to make room
+        absolute_time_t timeout = make_timeout_time_ms(BLOCK_WAIT_MS);
+        while (!(slot = victim()) && !time_reached(timeout))
+        {
+            startFlush();
+            service();
+        }
+        if (!slot)
+            return false;
+        slot->block = block;
+    }
+
+    memcpy(slot->data, src, BLOCK_SIZE);
+    slot->state = SLOT_DIRTY;
+    slot->lastUse = ++useCounter;
+    lastWrite = get_absolute_time();
+
+    if (policy == FLUSH_THROUGH)
+        return flush();
+    return true;
+}
+
+bool BlockCache::dirty()
+{
+    for (int i = 0; i < BLOCK_CACHE_SLOTS; i++)
+    {
+        if (slots[i].state == SLOT_DIRTY)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Write back the lowest dirty block, along with the dirty blocks that follow
+ * it, in one smb2_pwrite_async.  Only one write back is in flight at a time
+ */
+void BlockCache::startFlush()
+{
+    if (!smb2 || flushCount)
+        return;
+
+    Slot *first = nullptr;
+    for (int i = 0; i < BLOCK_CACHE_SLOTS; i++)
+    {
+        if (slots[i].state == SLOT_DIRTY && (!first || slots[i].block < first->block))
+            first = &slots[i];
+    }
+    if (!first)
+        return;
+
+    Slot *slot = first;
+    int count = 0;
+    while (count < BLOCK_FLUSH_BLOCKS && slot && slot->state == SLOT_DIRTY)
+    {
+        memcpy(&flushBuf[count * BLOCK_SIZE], slot->data, BLOCK_SIZE);
+        flushSlots[count++] = slot;
+        slot = find(first->block + count);
+    }
+
+    if (smb2_pwrite_async(smb2, fh, flushBuf, count * BLOCK_SIZE, (uint64_t)first->block * BLOCK_SIZE + headerSize, writeDone, first) < 0)
+    {
+        writeFailed = true;
+        flushAll = false;
+        return;
+    }
+    for (int i = 0; i < count; i++)
+        flushSlots[i]->state = SLOT_WRITING;
+    flushCount = count;
+    pending++;
+}
+
+bool BlockCache::flush()
+{
+    if (!smb2)
+        return true;
+
+    flushAll = true;
+    absolute_time_t timeout = make_timeout_time_ms(BLOCK_WAIT_MS);
+    while ((flushCount || (flushAll && dirty())) && !time_reached(timeout))
+    {
+        startFlush();
+        service();
+    }
+    flushAll = false;
+
+    bool ok = !writeFailed && !flushCount && !dirty();
+    writeFailed = false;
+    return ok;
+}
+
+int BlockCache::serviceSMB(struct smb2_context *smb2)
+{
+    struct pollfd pfd;
+    pfd.fd = smb2_get_fd(smb2);
+    pfd.events = smb2_which_events(smb2);
+    pfd.revents = 0;
+    if (poll(&pfd, 1, 0) < 0)
+        return 0;
+    return smb2_service(smb2, pfd.revents);
+}
+
+void BlockCache::service()
+{
+    if (!smb2)
+        return;
+
+    if (pending)
+    {
+        if (serviceSMB(smb2) < 0)
+        {
+            // The connection is gone, so nothing in flight will complete
+            for (int i = 0; i < BLOCK_CACHE_SLOTS; i++)
+            {
+                if (slots[i].state == SLOT_PENDING)
+                    slots[i].state = SLOT_EMPTY;
+                else if (slots[i].state == SLOT_WRITING)
+                    slots[i].state = SLOT_DIRTY;
+            }
+            pending = 0;
+            flushCount = 0;
+            flushAll = false;
+            writeFailed = true;
+            return;
+        }
+    }
+
+    if (!flushCount && dirty())
+    {
+        if (flushAll || (policy == FLUSH_IDLE && time_reached(delayed_by_ms(lastWrite, BLOCK_FLUSH_IDLE_MS))))
+            startFlush();
+    }
+}
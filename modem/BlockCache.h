@@ -0,0 +1,169 @@
+/*
+  BlockCache.h - read-ahead, write-back LRU cache of 512 byte disk image blocks
+  Stefan Wessels, 2023
+*/
+#ifndef _BLOCKCACHE_H
+#define _BLOCKCACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "pico/types.h"
+
+#define BLOCK_SIZE          512
+#define BLOCK_CACHE_SLOTS   16      // Blocks kept per drive, 8K of heap while it is mounted
+#define BLOCK_READ_AHEAD    4       // Blocks prefetched once a sequential run is seen
+#define BLOCK_RUN_LENGTH    2       // Ascending requests in a row that make a run
+#define BLOCK_FLUSH_BLOCKS  8       // Most adjacent dirty blocks written with one smb2_pwrite
+#define BLOCK_FLUSH_IDLE_MS 250     // FLUSH_IDLE writes dirty blocks once writes stop this long
+
+struct smb2_context;
+struct smb2fh;
+
+/*
+ * Cache in front of a disk image opened over SMB.  Nothing here waits on the
+ * network, except flush() and end() and write() when every slot is dirty.
+ * Misses and prefetches are issued with smb2_pread_async, and service()
+ * moves those along, so it should be called whenever there is nothing else
+ * to do.
+ * When requests come in as a run of ascending blocks, the next
+ * BLOCK_READ_AHEAD blocks are requested ahead of time, while the current
+ * block is still being sent.  Slots are reused least recently used first, so
+ * blocks that are read over and over (directories, the volume bitmap) stay.
+ *
+ * Written blocks are kept dirty in the cache and write() returns at once.
+ * Dirty blocks are written back with smb2_pwrite_async, adjacent ones
+ * together, when the FlushPolicy says so, when flush() is called, or when
+ * every slot is dirty and one is needed.
+ *
+ * The slots and the write back buffer are taken from the heap by begin()
+ * and given back by end(), so a drive that is not mounted costs no RAM.
+ * If end() gives up on a request, that RAM is left to the request, and
+ * what it completes is ignored.
+ */
+class BlockCache
+{
+public:
+    enum FlushPolicy
+    {
+        FLUSH_THROUGH,      // Every write goes to the server before write() returns
+        FLUSH_IDLE,         // Written back once BLOCK_FLUSH_IDLE_MS pass without a write
+        FLUSH_EXIT          // Written back only by flush(), or when the cache is full
+    };
+
+private:
+    enum SlotState
+    {
+        SLOT_EMPTY,
+        SLOT_PENDING,       // An async read is in flight
+        SLOT_VALID,
+        SLOT_DIRTY,         // Newer than the image
+        SLOT_WRITING        // Copied to flushBuf and being written back
+    };
+
+    struct Slot
+    {
+        BlockCache *cache;
+        uint32_t generation;    // The begin() the slot was made by
+        uint32_t block;
+        uint32_t lastUse;
+        SlotState state;
+        uint8_t data[BLOCK_SIZE];
+    };
+
+    struct smb2_context *smb2 = nullptr;
+    struct smb2fh *fh = nullptr;
+    uint32_t headerSize = 0;
+    uint32_t blocks = 0;
+    uint32_t useCounter = 0;
+    uint32_t lastBlock = 0;
+    int runLength = 0;
+    int pending = 0;
+    uint32_t generation = 0;        // Counts end()s, so late completions can be told apart
+    Slot *slots = nullptr;          // BLOCK_CACHE_SLOTS, from begin() to end()
+
+    bool writable = false;
+    FlushPolicy policy = FLUSH_IDLE;
+    absolute_time_t lastWrite;
+    bool flushAll = false;          // Keep writing back until nothing is dirty
+    bool writeFailed = false;
+    Slot *flushSlots[BLOCK_FLUSH_BLOCKS];
+    int flushCount = 0;             // Slots in the write back in flight, 0 if none
+    uint8_t *flushBuf = nullptr;    // BLOCK_FLUSH_BLOCKS blocks, from begin() to end()
+
+    static void readDone(struct smb2_context *smb2, int status, void *command_data, void *private_data);
+    static void writeDone(struct smb2_context *smb2, int status, void *command_data, void *private_data);
+    static bool hasData(Slot *slot) { return slot->state >= SLOT_VALID; }
+    Slot *find(uint32_t block);
+    Slot *victim();
+    bool request(uint32_t block);
+    void prefetch(uint32_t block);
+    bool dirty();
+    void startFlush();
+    bool waitFor(Slot *slot);
+
+public:
+    BlockCache() { end(); }
+
+    /**
+     * Serve blocks of an open image, with the data starting headerSize bytes in.
+     * imageSize is the size of the file, used to stop read-ahead at its end.
+     * writable is false if the image was opened read only.  Returns false if
+     * there is not the RAM for the cache
+     */
+    bool begin(struct smb2_context *smb2, struct smb2fh *fh, uint32_t headerSize, uint64_t imageSize, bool writable);
+
+    /**
+     * Write back dirty blocks, wait for reads in flight, forget all blocks
+     * and free the cache.  Call before closing the file
+     */
+    void end();
+
+    void setFlushPolicy(FlushPolicy policy) { this->policy = policy; }
+
+    /**
+     * The Apple II asked for block.  Start reading it if it is not cached,
+     * and when this makes a run of ascending blocks, read ahead too
+     */
+    void want(uint32_t block);
+    /**
+     * Copy a block to dest only if it is cached.  If not, its read is
+     * started (with a read-ahead if readAhead) and false is returned, so ask
+     * again later.  Never blocks
+     */
+    bool fetch(uint32_t block, uint8_t *dest, bool readAhead);
+
+    /**
+     * Copy a block to dest only if it is cached, without reading anything or
+     * counting it as used, so the SD mirror can look without moving blocks
+     * the Apple II uses out of the cache
+     */
+    bool peek(uint32_t block, uint8_t *dest);
+
+    /**
+     * Put a block in the cache to be written back.  Returns false if the
+     * image is read only, the block is past its end or there was no room
+     */
+    bool write(uint32_t block, const uint8_t *src);
+
+    /**
+     * Write back all dirty blocks and wait for that to finish.  Returns false
+     * if any write back failed since the last flush()
+     */
+    bool flush();
+
+    /**
+     * Progress reads and write backs in flight, and start write backs the
+     * flush policy calls for, without blocking
+     */
+    void service();
+
+    int inFlight() { return pending; }
+
+    /**
+     * Poll the SMB connection and let libsmb2 handle whatever is ready,
+     * without blocking.  Returns < 0 if the connection failed
+     */
+    static int serviceSMB(struct smb2_context *smb2);
+};
+
+#endif // _BLOCKCACHE_H
@@ -26,6 +26,8 @@ SOFTWARE.
 
 #ifdef USE_PIO
 
+#include <string.h>
+#include <hardware/dma.h>
 #include "RingBuf.h"
 #include "CoreBUS.h"
 
@@ -33,6 +35,10 @@ namespace Modem
 {
 extern RingBuffer c0rx;  // The queue that core 0 receives bytes on
 extern RingBuffer c0tx;
+extern int  bauds[];
+extern int  numBauds;
+extern byte serialspeed;
+extern bool callConnected;
 };
 
 extern const __attribute__((aligned(4))) uint8_t firmware[];
@@ -46,7 +52,39 @@ namespace CoreBUS
 #define SSC_COMMAND     0xA
 #define SSC_CONTROL     0xB
 
+// 6551 status
+#define STATUS_RDRF     0x08    // Receive data register full
+#define STATUS_TDRE     0x10    // Transmit data register empty
+#define STATUS_DCD      0x20    // No carrier
+#define STATUS_IRQ      0x80
+#define STATUS_UNKNOWN  0xFF    // Never a real status, so the next one is staged
+
+// 6551 command
+#define COMMAND_DTR     0x01    // Data terminal ready
+#define COMMAND_RX_OFF  0x02    // Receive interrupts disabled
+#define COMMAND_TX_MASK 0x0C
+#define COMMAND_TX_IRQ  0x04    // Transmit interrupts enabled
+#define COMMAND_ECHO    0x10
+#define COMMAND_KEEP    0xE0    // Parity, kept by a programmed reset
+
+#define CONTROL_BAUD    0x0F
+
 volatile bool active;
+volatile uint32_t dtrDrops;
+
+// The rates the 6551 control register selects.  0 is the external clock,
+// which on the SSC is 115200
+static const int aciaBauds[16] = {115200, 50, 75, 110, 135, 150, 300, 600, 1200, 1800, 2400, 3600, 4800, 7200, 9600, 19200};
+
+static uint8_t command, control;
+static uint8_t status;          // As staged
+static bool dcdChanged;         // Latched till the status is read, as on a 6551
+static bool staged;             // SSC_DATA holds the head of c0tx
+
+// What the Apple II reads at $C0nX and $CnXX, served by DMA.  Indexed by
+// A0-A10, so the 16 DEVSEL registers repeat through the first page and the
+// rest is the firmware
+uint8_t __attribute__((aligned(2048))) staging[2048];
 
 void bus_init()
 {
@@ -63,6 +101,37 @@ void bus_init()
     gpio_init(gpio_enbl);
     gpio_set_pulls(gpio_enbl, false, false);  // floating
 
+    gpio_init(gpio_res);
+    gpio_set_pulls(gpio_res, false, false);  // floating
+
+    // IRQ is open collector, so it is only ever driven low
+    gpio_init(gpio_irq);
+    gpio_set_pulls(gpio_irq, false, false);  // floating
+    gpio_put(gpio_irq, 0);
+
+    memset(staging, 0, 0x100);
+    memcpy(&staging[0x100], &firmware[0x100], sizeof(staging) - 0x100);
+
+    // The lookup address, from the lookup state machine, is written to the
+    // data channel's read address, which starts it.  The data channel moves
+    // the byte to the read state machine and then re-arms the lookup channel
+    int lookupDMA = dma_claim_unused_channel(true);
+    int dataDMA = dma_claim_unused_channel(true);
+
+    dma_channel_config c = dma_channel_get_default_config(dataDMA);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_chain_to(&c, lookupDMA);
+    dma_channel_configure(dataDMA, &c, &pio0->txf[sm_read], staging, 1, false);
+
+    c = dma_channel_get_default_config(lookupDMA);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio0, sm_lookup, false));
+    dma_channel_configure(lookupDMA, &c, &dma_hw->ch[dataDMA].al3_read_addr_trig, &pio0->rxf[sm_lookup], 1, true);
+
     uint offset;
 
     offset = pio_add_program(pio0, &enbl_program);
@@ -73,43 +142,132 @@ void bus_init()
 
     offset = pio_add_program(pio0, &read_program);
     read_program_init(offset);
+
+    offset = pio_add_program(pio0, &lookup_program);
+    lookup_program_init(offset, staging);
+}
+
+/*
+ * A DEVSEL register, wherever in $C0n0-$C0nF it is read from
+ */
+static inline void __time_critical_func(stage)(int port, uint8_t value)
+{
+    for (int i = port; i < 0x100; i += 0x10)
+        staging[i] = value;
+}
+
+static inline bool carrier(void)
+{
+    // Written by core 0
+    return *(volatile bool *)&Modem::callConnected;
 }
 
-typedef void (*port_function)();
-uint8_t values[0x10] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
-void __time_critical_func(empty)(void) {;}
-void __time_critical_func(ssc_data)(void) 
+/*
+ * Work out the status, and with it the IRQ line.  The Apple II receives
+ * the byte staged from c0tx - not whatever c0tx holds now, as core 0 may
+ * have added one since - and can send while c0rx has room
+ */
+static void __time_critical_func(stage_status)(void)
 {
-    int buffered = Modem::c0tx.available() ? 0b00011000 : 0b00010000;
-    if(buffered == 0b00011000) // was there something?
+    uint8_t next = 0;
+    if (staged)
+        next |= STATUS_RDRF;
+    if (!Modem::c0rx.is_full())
+        next |= STATUS_TDRE;
+    if (!carrier())
+        next |= STATUS_DCD;
+
+    if (status != STATUS_UNKNOWN && ((next ^ status) & STATUS_DCD))
+        dcdChanged = true;
+
+    bool rxIrq = (command & (COMMAND_DTR | COMMAND_RX_OFF)) == COMMAND_DTR && ((next & STATUS_RDRF) || dcdChanged);
+    bool txIrq = (command & COMMAND_TX_MASK) == COMMAND_TX_IRQ && (next & STATUS_TDRE);
+    if (rxIrq || txIrq)
+        next |= STATUS_IRQ;
+
+    if (next == status)
+        return;
+    status = next;
+    stage(SSC_STATUS, status);
+    gpio_set_dir(gpio_irq, (status & STATUS_IRQ) ? GPIO_OUT : GPIO_IN);
+}
+
+/*
+ * The byte at the head of c0tx, if any, and the status saying so.  The head
+ * is only consumed once the Apple II has read it
+ */
+static inline void __time_critical_func(stage_ssc)(void)
+{
+    staged = Modem::c0tx.available();
+    if (staged)
+        stage(SSC_DATA, Modem::c0tx.get());
+    stage_status();
+}
+
+static void set_command(uint8_t value)
+{
+    if ((command & COMMAND_DTR) && !(value & COMMAND_DTR))
+        dtrDrops++;
+    command = value;
+    stage(SSC_COMMAND, command);
+    stage_status();
+}
+
+static void set_control(uint8_t value)
+{
+    control = value;
+    stage(SSC_CONTROL, control);
+
+    // There is no wire to clock, but CONNECT reports the rate
+    int baud = aciaBauds[control & CONTROL_BAUD];
+    for (int i = 0; i < Modem::numBauds; i++)
     {
-        Modem::c0tx.advance(); // it was read so move on and see if there's something new
-        buffered = Modem::c0tx.available() ? 0b00011000 : 0b00010000;
-        values[SSC_DATA] = Modem::c0tx.get(); // load new char (or garbage)
+        if (Modem::bauds[i] == baud)
+            Modem::serialspeed = i;
     }
-    values[SSC_STATUS] = buffered; // set status as likely read next
 }
 
-void __time_critical_func(ssc_status)(void) 
+/*
+ * Power on, or the Apple II's RESET
+ */
+static void reset(void)
 {
-    // see if a character showed up
-    int buffered = Modem::c0tx.available() ? 0b00011000 : 0b00010000;
-    values[SSC_STATUS] = buffered; // set status to indicate availability
-    // If there is a new char, update values for data since that's probably read next
-    values[SSC_DATA] = Modem::c0tx.get(); 
+    status = STATUS_UNKNOWN;
+    dcdChanged = false;
+    staged = false;
+    set_command(0);
+    set_control(0);
 }
 
+/*
+ * The enbl state machine still reports every cycle, but DEVSEL and IOSEL
+ * reads have already been answered from staging, so here they only have
+ * side effects.  The C code answers only $C800-$CFFF reads, which depend on
+ * active
+ */
 void __time_critical_func(bus_interface)(void) 
 {
     active = false;
-    port_function portfunc[0x10] = {
-        &empty, &empty, &empty, &empty, &empty, &empty, &empty, &empty,
-        &ssc_data, &ssc_status,
-        &empty, &empty, &empty, &empty, &empty, &empty
-    };
+    reset();
 
     while (true) {
-        uint32_t enbl = pio_sm_get_blocking(pio0, sm_enbl);
+        if (pio_sm_is_rx_fifo_empty(pio0, sm_enbl)) {
+            if (!gpio_get(gpio_res)) {
+                active = false;
+                reset();
+                while (!gpio_get(gpio_res))
+                    tight_loop_contents();
+            }
+            // Between cycles, show newly arrived output, room in c0rx and
+            // carrier changes
+            if (!staged)
+                stage_ssc();
+            else
+                stage_status();
+            continue;
+        }
+
+        uint32_t enbl = pio_sm_get(pio0, sm_enbl);
         uint32_t addr = enbl & 0x0FFF;
         uint32_t io   = enbl & 0x0F00;  // IOSTRB or IOSEL
         uint32_t strb = enbl & 0x0800;  // IOSTRB
@@ -117,13 +275,19 @@ void __time_critical_func(bus_interface)(void)
 
         if (read) {
             if (!io) {  // DEVSEL
-                int port = addr & 0x0f;
-                pio_sm_put(pio0, sm_read, values[port]);
-                portfunc[port]();
-            } else {
-                if (!strb || active) {
-                    pio_sm_put(pio0, sm_read, firmware[addr]);
+                if ((addr & 0xF) == SSC_DATA && staged) {
+                    // That byte has been read, so move on to the next one
+                    uint8_t data = Modem::c0tx.get();
+                    Modem::c0tx.advance();
+                    if ((command & (COMMAND_ECHO | COMMAND_TX_MASK)) == COMMAND_ECHO)
+                        Modem::c0rx.Write(data);
+                    stage_ssc();
+                } else if ((addr & 0xF) == SSC_STATUS && dcdChanged) {
+                    dcdChanged = false;
+                    stage_status();
                 }
+            } else if (strb && active) {
+                pio_sm_put(pio0, sm_read, firmware[addr]);
             }
         } else {
             uint32_t data = pio_sm_get_blocking(pio0, sm_write);
@@ -133,6 +297,20 @@ void __time_critical_func(bus_interface)(void)
                 {
                     case SSC_DATA:
                         Modem::c0rx.Write(data);
+                        stage_status();
+                        break;
+
+                    case SSC_STATUS:
+                        // Programmed reset
+                        set_command(command & COMMAND_KEEP);
+                        break;
+
+                    case SSC_COMMAND:
+                        set_command(data);
+                        break;
+
+                    case SSC_CONTROL:
+                        set_control(data);
                         break;
                 }
             }
@@ -27,9 +27,12 @@ SOFTWARE.
 #ifndef _BUSCARD_H
 #define _BUSCARD_H
 
+#include <stdint.h>
+
 namespace CoreBUS
 {
 extern volatile bool active;
+extern volatile uint32_t dtrDrops;   // Times the Apple II turned DTR off
 
 void bus_init();
 void bus_interface();
@@ -2,13 +2,17 @@
 
 #include "RingBuf.h"
 #include "Serial.h"
+#include <pico/time.h>
+#include <hardware/sync.h>
 #include "CoreUART.h"
 #include <stdio.h>
 
 namespace Modem
 {
 extern int  bauds[];
+extern int  numBauds;
 extern byte serialspeed;
+extern bool autobaud;
 // This is a command queue - this "commands" the SSC - switch baud, etc.
 extern RingBuffer c0cmd;
 // These are the queues that core0 uses - core 0 sends on c0rx, core1 reads there
@@ -18,6 +22,10 @@ extern RingBuffer c0tx;
 
 namespace CoreUART
 {
+#define AUTOBAUD_IDLE_US    5000    // Quiet line needed before a falling edge is taken as the start of "AT"
+#define AUTOBAUD_SLICE_US   1000    // Longest one look for the start bit keeps the pump from its other work
+#define AUTOBAUD_MATCH      8       // Percent a measured bit may be off a rate in bauds[]
+
 Serial_ Serial;       // Connection over UART
 
 void init()
@@ -26,21 +34,101 @@ void init()
     Serial.setup(uart0, Modem::bauds[Modem::serialspeed], 8, 1, UART_PARITY_NONE);
 }
 
+/*
+ * How long to keep polling after the last activity.  A start bit wakes the
+ * core, but the byte lands in the ring only a character time later, and the
+ * last falling edge of a byte may come before its stop bit
+ */
+static uint32_t awakeUs(int baud)
+{
+    return 2 * 10 * 1000000 / baud;
+}
+
+/*
+ * The bauds[] index whose bit time is closest to bitNs, or -1 if none is
+ * close.  300 is left out; its bits are too close to the idle gap to tell
+ * from a line that has just gone quiet
+ */
+static int matchBaud(uint32_t bitNs)
+{
+    for(int i=1; i<Modem::numBauds; i++)
+    {
+        uint32_t expected = 1000000000 / Modem::bauds[i];
+        uint32_t diff = bitNs > expected ? bitNs - expected : expected - bitNs;
+        if(diff * 100 <= expected * AUTOBAUD_MATCH)
+            return i;
+    }
+    return -1;
+}
+
+/*
+ * Look, briefly, for the start bit of an "AT" and if its length is a known
+ * rate, switch to it.  The idle line before it may span many looks.  The A
+ * was received at the old rate, so it is put in c0rx in place of whatever the
+ * UART made of it
+ */
+static bool autobaudStep(uint32_t &awake)
+{
+    uint32_t bitNs = Serial.measureBit(AUTOBAUD_IDLE_US, AUTOBAUD_SLICE_US);
+    if(!bitNs)
+        return false;
+    // A start bit at no known rate leaves only garbage in the UART
+    int index = matchBaud(bitNs);
+    if(index < 0)
+    {
+        Serial.discard();
+        return false;
+    }
+
+    // measureBit returns as the start bit ends, so let the A's 8 data bits
+    // and half its stop bit go by, and change the UART before the T starts
+    busy_wait_us(bitNs * 17 / 2000);
+    Serial.baud(Modem::bauds[index]);
+    Serial.discard();
+    Modem::c0rx.Write('A');
+    Modem::serialspeed = index;
+    awake = awakeUs(Modem::bauds[index]);
+    return true;
+}
+
 void uart_interface(void)
 {
+    const uint8_t *txSpan;
+    size_t txLen = 0;           // Bytes of c0tx the TX DMA is sending
+    uint32_t awake = awakeUs(Modem::bauds[Modem::serialspeed]);
+    uint32_t lastActive = time_us_32();
+    bool hunting = Modem::autobaud;     // Looking for the rate of the next AT
+
+    Serial.wakeOnActivity();
     while(true)
     {
+        // Activity from here on wakes the WFE below
+        Serial.clearActivity();
+        bool active = false;
+
         if(Modem::c0cmd.available())
         {
+            active = true;
             uint8_t chr = Modem::c0cmd.Read();
             switch(chr)
             {
                 case 'B':
                 {
                     chr = Modem::c0cmd.Read();
+                    // Let what is going out go at the old speed
+                    while(Serial.writing())
+                        tight_loop_contents();
                     Serial.baud(Modem::bauds[chr]);
+                    awake = awakeUs(Modem::bauds[chr]);
+                    hunting = false;
                 }
                 break;
+
+                case 'A':
+                    while(Serial.writing())
+                        tight_loop_contents();
+                    hunting = true;
+                break;
                 
                 case 'S':
                     goto exit_loop;
@@ -52,18 +140,41 @@ void uart_interface(void)
             }
         }
 
-        // Look at a multi-byte read here
-        while(Serial.available())
+        // Nothing received is any use until the rate is known
+        if(hunting)
         {
-            uint8_t chr = Serial.Read();
-            Modem::c0rx.Write(chr);
+            hunting = !autobaudStep(awake);
+            active = true;
         }
 
-        while(Modem::c0tx.available())
+        // Received bytes go straight into the free span of c0rx
+        uint8_t *rxSpan;
+        size_t len = Modem::c0rx.write_span(&rxSpan);
+        if(len && (len = Serial.Read(rxSpan, len)))
         {
-            uint8_t chr = Modem::c0tx.Read();
-            Serial.Write(chr);
+            Modem::c0rx.commit(len);
+            active = true;
         }
+
+        // The TX DMA sends whole contiguous runs of c0tx, straight from the
+        // ring, which is only consumed once they are sent
+        if(txLen && !Serial.writing())
+        {
+            Modem::c0tx.consume(txLen);
+            txLen = 0;
+        }
+        if(!txLen && (txLen = Modem::c0tx.read_span(&txSpan)))
+        {
+            Serial.writeStart(txSpan, txLen);
+            active = true;
+        }
+
+        // Sleep till core 0 rings the doorbell on a queue, a start bit comes
+        // in or the send finishes
+        if(active)
+            lastActive = time_us_32();
+        else if(time_us_32() - lastActive > awake)
+            __wfe();
     }
 exit_loop:;
 }
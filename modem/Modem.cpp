@@ -37,13 +37,16 @@
 */
 
 #include <errno.h>
+#include <stdlib.h>
 #include <fcntl.h>
+#include <time.h>
 
 #include <pico/types.h>
 #include <pico/time.h>
 #include <pico/cyw43_arch.h>
 #include <hardware/flash.h>
 #include <hardware/flash.h>
+#include <hardware/clocks.h>
 #include "pico/multicore.h"
 
 #include <FreeRTOS.h>
@@ -57,11 +60,17 @@
 #include <smb2/libsmb2.h>
 
 #include "WiFi.h"
+#include "WiFiServer.h"
 #include "WString.h"
 #include "RingBuf.h"
 #include "MemBuffer.h"
 #include "NTPClient.h"
+#include "Telnet.h"
+#include "BlockCache.h"
+#include "SDImage.h"
+#include "SSHKey.h"
 #include "CoreUART.h"
+#include "CoreBUS.h"
 
 namespace Modem
 {
@@ -72,7 +81,7 @@ String build = __TIMESTAMP__;
 // For saving to flash
 #define MEM_SAVE_SIZE 1024       // Max size at the moment
 #define FLASH_END_ZONE_KILO 2044 // * 1024 for offset in flash of where to save
-#define CURRENT_SAVE_VERSION 0
+#define CURRENT_SAVE_VERSION 3  // 1 added ssh_key, 2 s7, 3 listenPort and s0
 MemBuffer flashSaveBuffer;
 bool sd_init_driver = false;
 
@@ -97,9 +106,15 @@ absolute_time_t plusTime = nil_time; // When did we last receive a "+++" sequenc
 absolute_time_t ledTime = nil_time;
 
 String speedDials[10];
-int bauds[] = {300, 1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200};
-byte serialspeed = 5;
+int bauds[] = {300, 1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600};
+#define NUM_BAUDS (sizeof(bauds) / sizeof(bauds[0]))
+int numBauds = NUM_BAUDS;
+#define BAUD_AUTO_FLAG  0x80    // Saved with serialspeed when autobaud is on
+#define BAUD_TOLERANCE  3       // Percent the UART divider may miss a rate by
+byte serialspeed = 5;           // Core 1 sets this when autobaud locks on
+bool autobaud = false;          // Core 1 sets the rate from the next AT
 String ssid, password, ssh_user, ssh_pass;
+String ssh_key;                 // SSHKey private key as hex, "" for none
 
 #define TX_BUF_SIZE 512+32 // Buffer where to Read from serial before writing to TCP, or for sending as adtVServer
 uint8_t txBuf[TX_BUF_SIZE];
@@ -119,24 +134,107 @@ enum resultCodes_t
     R_NOANSWER
 };
 absolute_time_t connectTime = nil_time;
-
-// Telnet codes
-#define DO 0xfd
-#define WONT 0xfc
-#define WILL 0xfb
-#define DONT 0xfe
-
-WiFiClient tcpClient; // Connections over WiFi
+absolute_time_t dialTime = nil_time;    // When the last ATD started
+#define S7_DEFAULT 30               // Seconds to wait for a host to answer
+byte s7 = S7_DEFAULT;               // S7, as on a Hayes modem
+bool dialing = false;               // An ATD is waiting for the host to answer
+bool dialHandshake = false;         // The host answered and the SSH or TLS handshake is under way
+absolute_time_t dialDeadline;       // S7 after the ATD, for the answer and the handshake
+String dialHost;
+#define RING_MS     3000            // Between RINGs
+#define RING_LIMIT  10              // RINGs before an unanswered caller is hung up on
+WiFiServer server;                  // Incoming calls
+uint16_t listenPort = 0;            // AT$SP, 0 for no incoming calls
+byte s0 = 0;                        // S0, RINGs before answering, 0 for only with ATA
+int ringLine = -1;                  // The line a caller is ringing on
+int rings = 0;
+absolute_time_t nextRing;
+int64_t connectUs = -1;                 // From dialing to CONNECT
+int64_t firstByteUs = -1;               // From dialing to the first byte from the host
+
+#define MAX_CALLS       MAX_SOCK_NUM    // Calls kept up at once, one of them on the terminal
+#define CALL_HOLD_SIZE  2048            // Bytes a call in the background keeps for the terminal
+
+// How a call talks to its host, fixed when it is dialed or answered
+typedef enum CallMode_
+{
+    CALL_TCP,
+    CALL_SSH,
+    CALL_TLS,
+} CallMode;
+
+// A call stays up in the background while another is on the terminal.  What
+// its host sends is read into held, which keeps its TCP window open, until
+// held is full.  Switching back to the call with ATOn plays held back first
+typedef struct Call_
+{
+    WiFiClient client;
+    CallMode mode;
+    bool telnet;        // Telnet protocol handling, as ATNET was when the call was made
+    Telnet codec;       // and the state of it
+    bool connected;     // callConnected, while the call is in the background
+    absolute_time_t connectTime;
+    String name;        // host:port, as dialed
+    RingBuffer held{CALL_HOLD_SIZE};
+} Call;
+Call calls[MAX_CALLS];
+int currentCall = 0;                        // The call on the terminal
+WiFiClient *tcpClient = &calls[0].client;   // and its connection over WiFi
+Telnet *telnetCodec = &calls[0].codec;
+#define CORE_QUEUE_SIZE 1024 // Power of 2 that holds a whole VSDrive block (512+11) or TCP burst
 #ifdef USE_UART
-RingBuffer c0cmd;
+RingBuffer c0cmd(16);
 #endif
-RingBuffer c0rx;
-RingBuffer c0tx;
+RingBuffer c0rx(CORE_QUEUE_SIZE);
+RingBuffer c0tx(CORE_QUEUE_SIZE);
+
+#define VDRIVE_MAX          4       // Units the Apple II can use, each with its own cache
+#define VDRIVE_HEADER_SIZE  64      // Bytes read from the front of an image, to find a 2MG header
+#define VDRIVE_MOUNT_MS     10000   // Longest an SMB mount may take
+#define VDRIVE_WAIT_MS      5000    // Longest the Apple II waits for a block before it is failed
+#define VDRIVE_BYTE_MS      1000    // Longest wait for the rest of a command from the Apple II
+#ifdef PRODOS_FIRMWARE
+#define VDRIVE_BOOT_IMAGE   "sd:/prodos"    // prodos1.po and prodos2.po are mounted at power on
+#endif
+
+// One connection to an SMB share, shared by all the drives with images on it
+enum SMBSessionState
+{
+    SS_FREE,
+    SS_CONNECTING,
+    SS_CONNECTED,
+    SS_FAILED
+};
+
+typedef struct SMBSession_
+{
+    struct smb2_context *smb2;
+    String server, share, user;
+    SMBSessionState state;
+    int refs;           // Drives using this session
+} SMBSession;
+SMBSession smbSessions[VDRIVE_MAX];
+
+// Where a drive is in mounting an image.  SMB mounts go through the steps
+// in order, one async call each
+enum VDriveState
+{
+    VD_IDLE,
+    VD_CONNECT,     // Waiting for the session to connect
+    VD_OPEN,
+    VD_OPEN_RO,
+    VD_FSTAT,
+    VD_HEADER,
+    VD_READY,       // All steps done, waiting to be reported
+    VD_FAILED,      // A step failed, waiting to be reported
+    VD_MOUNTED
+};
 
 typedef struct VDrive_
 {
     // SMB2 structures
-    struct smb2_context *smb2;
+    SMBSession *session;
+    struct smb2_context *smb2;  // The session's, once it is connected
     struct smb2_url *url;
     // struct smb2dir *dir;
     struct smb2dirent *ent;
@@ -144,18 +242,44 @@ typedef struct VDrive_
     struct smb2_stat_64 st;
     int headerSize;
     bool mounted;
+    bool readOnly;
+    VDriveState state;
+    int inFlight;       // Mount requests waiting on the server
+    absolute_time_t mountTimeout;
+    uint8_t header[VDRIVE_HEADER_SIZE];
+    BlockCache cache;   // Blocks served from the image, with read-ahead and write-back
+    SDImage sd;         // The image on the SD card, or the SD copy of the SMB image
 } VDrive;
-VDrive vdrive[2];
+VDrive vdrive[VDRIVE_MAX];
+BlockCache::FlushPolicy vdriveFlush = BlockCache::FLUSH_IDLE;
+bool vdriveMirror = false;  // Copy SMB images to the SD card and serve from the copy
+
+// Where adtVPoll() is in talking to the Apple II
+enum VServeState
+{
+    VS_SYNC,        // Waiting for the 0xC5 that starts a command
+    VS_COMMAND,     // Waiting for the rest of the command
+    VS_DATA,        // Waiting for the block being written
+    VS_SEND         // Waiting for the block being read to come in
+};
+bool vdriveOnline = false;  // ATVSO - the Apple II is using the drives
+#ifdef PRODOS_FIRMWARE
+bool vdriveFrame = false;   // The card's block driver sent a command from AT command mode
+#endif
+byte vdriveSerialSpeed;     // Speed to go back to when the drives go offline
+VServeState vdriveState = VS_SYNC;
+int vdriveDrive, vdriveBlock;
+absolute_time_t vdriveTimeout;
 
 /**
- * Turn the connected delta time into a human readable string
+ * Turn the time connected since since into a human readable string
  */
-String connectTimeString()
+String connectTimeString(absolute_time_t since)
 {
     String out = "";
-    if (!is_nil_time(connectTime))
+    if (!is_nil_time(since))
     {
-        int secs = us_to_ms(absolute_time_diff_us(connectTime, get_absolute_time())) / 1000;
+        int secs = us_to_ms(absolute_time_diff_us(since, get_absolute_time())) / 1000;
         int mins = secs / 60;
         int hours = mins / 60;
         if (hours < 10)
@@ -196,6 +320,19 @@ int connectWiFi()
         c0tx.println(ssid);
         return -1;
     }
+
+    // Look the speed dials up now, so dialing them does not wait on DNS
+    for (int i = 0; i < 10; i++)
+    {
+        int portIndex = speedDials[i].indexOf(':');
+        String host = portIndex != -1 ? speedDials[i].substring(0, portIndex) : speedDials[i];
+        host.trim();
+        if (host.length())
+            WiFi.prefetch(host.c_str());
+    }
+
+    if (listenPort && !server.begin(listenPort))
+        c0tx.printf("COULD NOT LISTEN ON PORT %d\r\n", listenPort);
     return 0;
 }
 
@@ -220,7 +357,7 @@ void sendResult(int resultCode)
     }
     else if (resultCode == R_NOCARRIER)
     {
-        c0tx.print(String(resultCodes[R_NOCARRIER]) + " (" + connectTimeString() + ")");
+        c0tx.print(String(resultCodes[R_NOCARRIER]) + " (" + connectTimeString(connectTime) + ")");
     }
     else
     {
@@ -316,7 +453,7 @@ void saveSettings()
     Save(password);
     Save(ssh_user);
     Save(ssh_pass);
-    Save(serialspeed);
+    Save(byte(serialspeed | (autobaud ? BAUD_AUTO_FLAG : 0)));
     Save(byte(echo));
     Save(byte(hex));
     Save(byte(telnet));
@@ -327,6 +464,11 @@ void saveSettings()
     {
         Save(speedDials[i]);
     }
+    Save(ssh_key);
+    Save(s7);
+    Save(byte(listenPort >> 8));
+    Save(byte(listenPort));
+    Save(s0);
 
     vPortEnterCritical();
     flash_range_erase((FLASH_END_ZONE_KILO * 1024), FLASH_SECTOR_SIZE);
@@ -354,13 +496,17 @@ void loadSettings()
     hash3 = Load();
     hash4 = Load();
     saveVer = Load();
-    if (hash1 == 0x9C && hash2 == 0x15 && hash3 == 0x40 && hash4 == 0x85 && saveVer == CURRENT_SAVE_VERSION)
+    if (hash1 == 0x9C && hash2 == 0x15 && hash3 == 0x40 && hash4 == 0x85 && saveVer <= CURRENT_SAVE_VERSION)
     {
         ssid = LoadString();
         password = LoadString();
         ssh_user = LoadString();
         ssh_pass = LoadString();
         serialspeed = Load();
+        autobaud = serialspeed & BAUD_AUTO_FLAG;
+        serialspeed &= ~BAUD_AUTO_FLAG;
+        if (serialspeed >= NUM_BAUDS)
+            serialspeed = 4;
         echo = Load();
         hex = Load();
         telnet = Load();
@@ -371,8 +517,24 @@ void loadSettings()
         {
             speedDials[i] = LoadString();
         }
+        ssh_key = saveVer >= 1 ? LoadString() : "";
+        s7 = saveVer >= 2 ? Load() : S7_DEFAULT;
+        if (!s7)
+            s7 = S7_DEFAULT;
+        if (saveVer >= 3)
+        {
+            listenPort = Load() << 8;
+            listenPort |= Load();
+            s0 = Load();
+        }
+        else
+        {
+            listenPort = 0;
+            s0 = 0;
+        }
     }
     vPortExitCritical();
+    SSHKey::load(ssh_key);
 }
 
 /**
@@ -382,7 +544,9 @@ void displaySavedSettings()
 {
     uint8_t i, hash1, hash2, hash3, hash4, temp[6], saveVer = CURRENT_SAVE_VERSION;
     flashSaveBuffer.begin((uint8_t *)(XIP_BASE + (FLASH_END_ZONE_KILO * 1024)), MEM_SAVE_SIZE);
-    String tempStr[4], speedStr[10];
+    String tempStr[4], speedStr[10], keyStr;
+    uint8_t savedS7 = S7_DEFAULT, savedS0 = 0;
+    uint16_t savedPort = 0;
 
     vPortEnterCritical();
     hash1 = Load();
@@ -390,9 +554,9 @@ void displaySavedSettings()
     hash3 = Load();
     hash4 = Load();
     saveVer = Load();
-    if (hash1 == 0x9C && hash2 == 0x15 && hash3 == 0x40 && hash4 == 0x85 && saveVer == CURRENT_SAVE_VERSION)
+    if (hash1 == 0x9C && hash2 == 0x15 && hash3 == 0x40 && hash4 == 0x85 && saveVer <= CURRENT_SAVE_VERSION)
     {
-        if (saveVer == CURRENT_SAVE_VERSION)
+        if (saveVer <= CURRENT_SAVE_VERSION)
         {
             for (i = 0; i < 4; i++)
                 tempStr[i] = LoadString();
@@ -400,12 +564,22 @@ void displaySavedSettings()
                 temp[i] = Load();
             for (i = 0; i < 10; i++)
                 speedStr[i] = LoadString();
+            if (saveVer >= 1)
+                keyStr = LoadString();
+            if (saveVer >= 2)
+                savedS7 = Load();
+            if (saveVer >= 3)
+            {
+                savedPort = Load() << 8;
+                savedPort |= Load();
+                savedS0 = Load();
+            }
         }
     }
     vPortExitCritical();
     if (hash1 == 0x9C && hash2 == 0x15 && hash3 == 0x40 && hash4 == 0x85)
     {
-        if (saveVer == CURRENT_SAVE_VERSION)
+        if (saveVer <= CURRENT_SAVE_VERSION)
         {
             c0tx.printf("SSID = %s\r\n", tempStr[0].c_str());
             c0tx.printf("PASSWORD = %s\r\n", tempStr[1].c_str());
@@ -414,7 +588,7 @@ void displaySavedSettings()
             if (tempStr[3].length())
                 c0tx.print("********");
             c0tx.println();
-            c0tx.printf("BAUD = %d (%d)\r\n", bauds[temp[0]], temp[0]);
+            c0tx.printf("BAUD = %d (%d)%s\r\n", bauds[temp[0] & ~BAUD_AUTO_FLAG], temp[0] & ~BAUD_AUTO_FLAG, temp[0] & BAUD_AUTO_FLAG ? " AUTO" : "");
             c0tx.printf("ECHO = %d\r\n", temp[1]);
             c0tx.printf("HEX = %d\r\n", temp[2]);
             c0tx.printf("TELNET = %d\r\n", temp[3]);
@@ -422,6 +596,10 @@ void displaySavedSettings()
             c0tx.printf("QUIET MODE = %d\r\n", temp[5]);
             for (i = 0; i < 10; i++)
                 c0tx.printf("Speed Dial %d = %s\r\n", i, speedStr[i].c_str());
+            c0tx.printf("SSH KEY = %s\r\n", keyStr.length() ? "SET" : "NONE");
+            c0tx.printf("S7 = %d\r\n", savedS7);
+            c0tx.printf("LISTEN PORT = %d\r\n", savedPort);
+            c0tx.printf("S0 = %d\r\n", savedS0);
         }
         else
         {
@@ -443,7 +621,13 @@ void defaultSettings()
     password = "";
     ssh_user = "";
     ssh_pass = "";
+    ssh_key = "";
+    SSHKey::load(ssh_key);
+    s7 = S7_DEFAULT;
+    listenPort = 0;
+    s0 = 0;
     serialspeed = 4;
+    autobaud = false;
     echo = true;
     hex = false;
     telnet = false; // Is telnet control code handling enabled
@@ -486,9 +670,50 @@ void scanNetworks()
  */
 void disconnectWiFi()
 {
+    server.stop();
     WiFi.disconnect();
 }
 
+/**
+ * The rate the UART really runs at for a requested baud.  This is the
+ * pico-sdk's uart_set_baudrate divider math: a 16.6 fixed point divider of
+ * clk_peri / 16
+ */
+int actualBaudRate(int baud)
+{
+    uint32_t clock = clock_get_hz(clk_peri);
+    uint32_t div = (8 * clock / baud) + 1;
+    uint32_t ibrd = div >> 7;
+    uint32_t fbrd = (div & 0x7f) >> 1;
+
+    if (ibrd == 0)
+    {
+        ibrd = 1;
+        fbrd = 0;
+    }
+    else if (ibrd >= 65535)
+    {
+        ibrd = 65535;
+        fbrd = 0;
+    }
+    return (int)((4 * (uint64_t)clock) / (64 * ibrd + fbrd));
+}
+
+/**
+ * Let core 1 find the rate from the start bit of the next "AT"
+ */
+void setAutoBaud()
+{
+    autobaud = true;
+#ifdef USE_UART
+    c0tx.println("TYPE AT AT THE NEW SPEED");
+    sendResult(R_OK);
+    c0cmd.Write('A');
+#else
+    sendResult(R_OK);
+#endif
+}
+
 /**
  * Make sure the new rate is valid.  Inform the user the baud rate will change in 5 seconds and do so after 5
  */
@@ -500,7 +725,7 @@ void setBaudRate(int inSpeed)
         return;
     }
     int foundBaud = -1;
-    for (int i = 0; i < sizeof(bauds) / sizeof(bauds[0]); i++)
+    for (int i = 0; i < NUM_BAUDS; i++)
     {
         if (inSpeed == bauds[i])
         {
@@ -515,14 +740,29 @@ void setBaudRate(int inSpeed)
         sendResult(R_ERROR);
         return;
     }
-    if (foundBaud == serialspeed)
+
+    // The divider can not get close enough to the rate
+    int actual = actualBaudRate(inSpeed);
+    if (abs(actual - inSpeed) * 100 > inSpeed * BAUD_TOLERANCE)
+    {
+        sendResult(R_ERROR);
+        return;
+    }
+    if (foundBaud == serialspeed && !autobaud)
     {
         sendResult(R_OK);
         return;
     }
+    autobaud = false;
 #ifdef USE_UART
     c0tx.print("SWITCHING SERIAL PORT TO ");
     c0tx.print(inSpeed);
+    if (actual != inSpeed)
+    {
+        c0tx.print(" (ACTUAL ");
+        c0tx.print(actual);
+        c0tx.print(")");
+    }
     c0tx.println(" IN 5 SECONDS");
     delay(5000);
     c0cmd.Write('B');
@@ -568,6 +808,10 @@ void displayNetworkStatus()
     }
     c0tx.print("SSID.......: ");
     c0tx.println(WiFi.SSID());
+    uint8_t bssid[6];
+    WiFi.BSSID(bssid);
+    c0tx.printf("AP.........: %02X:%02X:%02X:%02X:%02X:%02X\r\n", bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
+    c0tx.printf("SIGNAL.....: %d DBM, ROAMING %s\r\n", (int)WiFi.RSSI(), WiFi.roaming ? "ON" : "OFF");
 
     //  c0tx.print("ENCRYPTION: ");
     //  switch(WiFi.encryptionType()) {
@@ -617,12 +861,20 @@ void displayNetworkStatus()
     if (callConnected)
     {
         c0tx.print("CALL LENGTH: ");
-        c0tx.println(connectTimeString());
+        c0tx.println(connectTimeString(connectTime));
     }
     else
     {
         c0tx.println("NOT CONNECTED");
     }
+    if (connectUs >= 0)
+    {
+        c0tx.printf("LAST DIAL..: CONNECT %d MS%s, FIRST BYTE ", (int)(connectUs / 1000), tcpClient->tlsResumed ? " (TLS RESUMED)" : "");
+        if (firstByteUs >= 0)
+            c0tx.printf("%d MS\r\n", (int)(firstByteUs / 1000));
+        else
+            c0tx.println("NONE YET");
+    }
     c0tx.print("DATE & TIME: ");
     c0tx.println(ntp.getFormattedDate());
 }
@@ -645,6 +897,8 @@ void displayCurrentSettings()
     if(ssh_pass.length())
         c0tx.print("********");
     c0tx.println();
+    c0tx.print("SSH KEY: ");
+    c0tx.println(SSHKey::loaded() ? SSHKEY_TYPE : "NONE");
     c0tx.print("E");
     c0tx.print(echo);
     c0tx.print(" ");
@@ -656,7 +910,18 @@ void displayCurrentSettings()
     c0tx.print(" ");
     c0tx.print("NET");
     c0tx.print(telnet);
+    c0tx.print(" ");
+    c0tx.print("S7=");
+    c0tx.print(s7);
+    c0tx.print(" ");
+    c0tx.print("S0=");
+    c0tx.print(s0);
     c0tx.println();
+    c0tx.print("LISTEN PORT: ");
+    if (listenPort)
+        c0tx.println(listenPort);
+    else
+        c0tx.println("OFF");
 
     c0tx.println("SPEED DIAL:");
     for (int i = 0; i < 10; i++)
@@ -717,20 +982,36 @@ void displayHelp()
     c0tx.println("SET SSH USER NAME....: AT$SSHU=SSHUSERNAME");
     c0tx.println("SET SSH PASSWORD.....: AT$SSHP=SSHPASSWORD");
     c0tx.println("SSH DIAL.............: ATSSHHOST:PORT");
-    c0tx.println("HTTP GET.............: ATGET<URL>");
+    c0tx.println("TLS DIAL.............: ATDTLSHOST:PORT");
+    c0tx.println("MAKE SSH KEY.........: AT$SSHKEYGEN");
+    c0tx.println("SHOW SSH PUBLIC KEY..: AT$SSHKEY?");
+    c0tx.println("FORGET SSH KEY.......: AT$SSHKEYDEL");
+    c0tx.println("HTTP(S) GET..........: ATGET<URL>");
     c0tx.println("GOPHER REQUEST.......: ATGPH<URL>");
     waitForSpace();
     c0tx.println("HANDLE TELNET........: ATNETN (N=0,1)");
-    c0tx.println("MOUNT SMB VSDRIVE....: ATVSNSMB://HOST/FILEPATH (N=1-2)");
+    c0tx.println("ROAM BETWEEN APS.....: ATROAMN (N=0,1)");
+    c0tx.println("MOUNT SMB VSDRIVE....: ATVSNSMB://HOST/FILEPATH (N=1-4)");
+    c0tx.println("MOUNT SD VSDRIVE.....: ATVSNSD:/FILEPATH (N=1-4)");
+    c0tx.println("MIRROR SMB TO SD.....: ATVSM0 / ATVSM1");
+    c0tx.println("VSDRIVE WRITE MODE...: ATVSWN (N=0 THROUGH,");
+    c0tx.println("                        1 IDLE, 2 OFFLINE)");
     c0tx.println("VSDRIVE ONLINE.......: ATVSO");
     c0tx.println("ECHO OFF/ON..........: ATE0 / ATE1");
     c0tx.println("QUIET MODE OFF/ON....: ATQ0 / ATQ1");
     c0tx.println("VERBOSE OFF/ON.......: ATV0 / ATV1");
     c0tx.println("SET BAUD RATE........: AT$SB=N (3,12,24,48,96");
-    c0tx.println("                        192,384,576,1152)*100");
-    c0tx.println("HANGUP...............: ATH");
+    c0tx.println("                        192,384,576,1152,2304");
+    c0tx.println("                        4608,9216)*100");
+    c0tx.println("AUTO BAUD RATE.......: AT$SB=A");
+    c0tx.println("HANGUP...............: ATH / ATHN (CALL N=1-4)");
+    c0tx.println("LIST CALLS...........: AT$CALL?");
+    c0tx.println("ANSWER WAIT (SECS)...: ATS7=N (N=1-255)");
+    c0tx.println("LISTEN FOR CALLS.....: AT$SP=PORT (0=OFF)");
+    c0tx.println("ANSWER...............: ATA");
+    c0tx.println("AUTO ANSWER (RINGS)..: ATS0=N (0=OFF)");
     c0tx.println("ENTER CMD MODE.......: +++");
-    c0tx.println("EXIT CMD MODE........: ATO");
+    c0tx.println("EXIT CMD MODE........: ATO / ATON (CALL N=1-4)");
     c0tx.println("LOAD SETTINGS........: ATZ");
     c0tx.println("SAVE SETTINGS........: AT&W");
     c0tx.println("SHOW SAVED SETTINGS..: AT&V?");
@@ -767,18 +1048,142 @@ void led_set(bool on)
 }
 
 /**
- * Make a TCP connection to a remote host.  Possibly wrap the connection in SSH
+ * Is line n in use - with a call up or ringing, or one whose host has hung up
+ * but that still holds what the host sent before it did
  */
-void dialOut(String upCmd)
+bool callInUse(int n)
 {
-    int numberIndex = 4;
+    if (n == ringLine)
+        return true;
+    if (n == currentCall)
+        return callConnected || dialing;
+    return calls[n].connected || !calls[n].held.is_empty();
+}
 
-    // Can't place a call while in a call
-    if (callConnected)
+/**
+ * Put call n on the terminal.  The call that was there carries on in the background
+ */
+void switchCall(int n)
+{
+    calls[currentCall].connected = callConnected;
+    calls[currentCall].connectTime = connectTime;
+    currentCall = n;
+    tcpClient = &calls[n].client;
+    telnetCodec = &calls[n].codec;
+    callConnected = calls[n].connected || !calls[n].held.is_empty();
+    connectTime = calls[n].connectTime;
+}
+
+/**
+ * Find a line for a new call to name, moving the call on the terminal, if
+ * there is one, to the background.  false if every line is in use.  Telnet
+ * handling is left off if telnet is false
+ */
+bool newCall(const String &name, CallMode mode, bool telnet)
+{
+    if (callInUse(currentCall))
+    {
+        int n = 0;
+        while (n < MAX_CALLS && callInUse(n))
+            n++;
+        if (n == MAX_CALLS)
+            return false;
+        switchCall(n);
+    }
+    Call &call = calls[currentCall];
+    call.held.consume(call.held.readable());
+    call.mode = mode;
+    call.telnet = telnet;
+    call.codec.reset();
+    call.name = name;
+    return true;
+}
+
+/**
+ * Hang up call n, one in the background or one still ringing
+ */
+void dropCall(int n)
+{
+    Call &call = calls[n];
+    if (n == ringLine)
+        ringLine = -1;
+    call.client.stop();
+    call.codec.reset();
+    call.held.consume(call.held.readable());
+    call.connected = false;
+    call.connectTime = nil_time;
+}
+
+/**
+ * Read what hosts send to the calls not on the terminal, and to the one on
+ * the terminal while in command mode, into their held buffers, so the hosts
+ * are not stalled by a closed TCP window.  A call in the background whose
+ * host hangs up is listed until what it held has been seen
+ */
+void holdCalls()
+{
+    for (int i = 0; i < MAX_CALLS; i++)
     {
-        sendResult(R_ERROR);
-        return;
+        Call &call = calls[i];
+        if (i == currentCall ? !(cmdMode && callConnected) : !call.connected)
+            continue;
+
+        uint8_t *span;
+        size_t spanSize;
+        while (call.client.available() > 0 && (spanSize = call.held.write_span(&span)))
+        {
+            int len = call.client.Read(span, spanSize);
+            if (len <= 0)
+                break;
+            if (call.telnet)
+                len = call.codec.decode(span, len, span);
+            call.held.commit(len);
+        }
+        if (i != currentCall && !call.client.connected() && call.client.available() <= 0)
+        {
+            call.client.stop();
+            call.connected = false;
+        }
     }
+}
+
+/**
+ * List the calls, marking the one on the terminal with a *
+ */
+void displayCalls()
+{
+    bool none = true;
+    for (int i = 0; i < MAX_CALLS; i++)
+    {
+        if (!callInUse(i))
+            continue;
+        Call &call = calls[i];
+        bool up = i == currentCall ? callConnected && tcpClient->connected() : call.connected;
+        c0tx.printf("%d%c %s ", i + 1, i == currentCall ? '*' : ' ', call.name.c_str());
+        if (i == currentCall && dialing)
+            c0tx.print("DIALING");
+        else if (up)
+            c0tx.print(connectTimeString(i == currentCall ? connectTime : call.connectTime));
+        else
+            c0tx.print(resultCodes[R_NOCARRIER]);
+        if (!call.held.is_empty())
+            c0tx.printf(", %d BYTES HELD", (int)call.held.readable());
+        c0tx.println();
+        none = false;
+    }
+    if (none)
+        c0tx.println("NO CALLS");
+}
+
+/**
+ * Make a TCP connection to a remote host.  Possibly wrap the connection in SSH or TLS
+ */
+void dialOut(String upCmd)
+{
+    int numberIndex = 4;
+    bool ssh = upCmd.indexOf("ATDSSH") == 0;
+    bool tls = upCmd.indexOf("ATDTLS") == 0;
+
     String host, port;
     int portIndex;
     // Dialing a stored number (note atdssh excluded)
@@ -800,7 +1205,7 @@ void dialOut(String upCmd)
     else
     {
         // Dialing an ad-hoc number
-        if (upCmd.indexOf("ATDSSH") == 0)
+        if (ssh || tls)
             numberIndex = 6;
 
         int portIndex = cmd.indexOf(":");
@@ -812,8 +1217,10 @@ void dialOut(String upCmd)
         else
         {
             host = cmd.substring(numberIndex, cmd.length());
-            if (numberIndex == 6)
+            if (ssh)
                 port = "22"; // SSH default
+            else if (tls)
+                port = "992"; // Telnet over TLS default
             else
                 port = "23"; // Telnet default
         }
@@ -821,36 +1228,90 @@ void dialOut(String upCmd)
     host.trim(); // remove leading or trailing spaces
     port.trim();
 
+    // A call already up goes to the background, if there is a line free
+    // Telnet is never spoken inside SSH, which has its own terminal handling
+    if (!newCall(host + ":" + port, ssh ? CALL_SSH : tls ? CALL_TLS : CALL_TCP, telnet && !ssh))
+    {
+        sendResult(R_ERROR);
+        return;
+    }
     c0tx.print("DIALING ");
     c0tx.print(host);
     c0tx.print(":");
     c0tx.println(port);
     int portInt = port.toInt();
-    if (tcpClient.tcp_connect(host.c_str(), portInt))
+    dialTime = get_absolute_time();
+    connectUs = firstByteUs = -1;
+    tcpClient->hostKeyChanged = false;
+    // loop() waits for the answer, with dialPoll()
+    if (!tcpClient->connectStart(host.c_str(), portInt, s7 * 1000))
+    {
+        sendResult(R_NOANSWER);
+        return;
+    }
+    dialHost = host;
+    dialHandshake = false;
+    dialDeadline = make_timeout_time_ms(s7 * 1000);
+    dialing = true;
+}
+
+/**
+ * Move a dial along, without blocking.  Once the host answers, an SSH or TLS
+ * handshake is moved along a step at a time too.  As on a Hayes modem, a key
+ * pressed while dialing abandons the call, and S7 seconds without an answer,
+ * handshake included, ends it
+ */
+void dialPoll()
+{
+    int ret;
+
+    if (c0rx.available())
+    {
+        c0rx.Read();
+        dialing = false;
+        tcpClient->stop();
+        sendResult(R_NOCARRIER);
+        return;
+    }
+    if (!dialHandshake)
+    {
+        if ((ret = tcpClient->connectPoll()) == CONNECT_WAIT)
+            return;
+        if (ret && calls[currentCall].mode == CALL_SSH)
+            dialHandshake = ret = tcpClient->sshStart(ssh_user.c_str(), ssh_pass.c_str());
+        else if (ret && calls[currentCall].mode == CALL_TLS)
+            dialHandshake = ret = tcpClient->tlsStart(dialHost.c_str());
+    }
+    if (dialHandshake)
+    {
+        if (time_reached(dialDeadline))
+            ret = 0;
+        else if ((ret = calls[currentCall].mode == CALL_SSH ? tcpClient->sshPoll() : tcpClient->tlsPoll()) == CONNECT_WAIT)
+            return;
+    }
+    dialing = false;
+
+    if (ret)
     {
         callConnected = true;
-        if (numberIndex == 6)
-        {
-            if (!tcpClient.ssh_connect(ssh_user.c_str(), ssh_pass.c_str()))
-                callConnected = false;
-            else
-                tcpClient.setNoDelay(true); // Try to enable naggle
-        }
-        if (callConnected)
-        {
-            tcpClient.setNoDelay(true); // Try to disable naggle
-            sendResult(R_CONNECT);
-            connectTime = get_absolute_time();
-            cmdMode = false;
-            // c0tx.flush();
-        }
+        tcpClient->setNoDelay(true); // Try to disable naggle
+        // Ask for character at a time mode from telnet servers
+        if (calls[currentCall].telnet)
+            telnetCodec->requestHim(TELOPT_SGA, true);
+        sendResult(R_CONNECT);
+        connectTime = get_absolute_time();
+        connectUs = absolute_time_diff_us(dialTime, connectTime);
+        cmdMode = false;
+        // c0tx.flush();
     }
 
     if (!callConnected)
     {
+        if (tcpClient->hostKeyChanged)
+            c0tx.println("HOST KEY CHANGED");
         sendResult(R_NOANSWER);
         callConnected = false;
-        tcpClient.stop();
+        tcpClient->stop();
     }
 }
 
@@ -859,20 +1320,103 @@ void dialOut(String upCmd)
  */
 void hangUp()
 {
-    tcpClient.stop();
+    if (ringLine == currentCall)
+        ringLine = -1;
+    tcpClient->stop();
     callConnected = false;
+    telnetCodec->reset();
+    calls[currentCall].held.consume(calls[currentCall].held.readable());
     sendResult(R_NOCARRIER);
     connectTime = nil_time;
+    dialTime = nil_time;
 }
 
-void adtVSend(int drive, int block)
+/**
+ * Take the call ringing on ringLine
+ */
+void answerCall()
 {
-    const int size = 512;
-    const int DATA_START = 9;
-    const int offset = block * 512 + vdrive[drive].headerSize;
+    int n = ringLine;
+    ringLine = -1;
+    switchCall(n);
+    callConnected = true;
+    tcpClient->setNoDelay(true); // Try to disable naggle
+    sendResult(R_CONNECT);
+    connectTime = get_absolute_time();
+    cmdMode = false;
+}
 
-    if(!vdrive[drive].mounted)
+/**
+ * Let callers in.  A caller rings, on the line on the terminal, while the
+ * modem sits in command mode with no call on the terminal, and is answered
+ * with ATA, or after S0 RINGs.  Other callers get an RST as soon as they
+ * are accepted, so they know at once the line is busy, and the call in
+ * progress is not held up
+ */
+void ringPoll()
+{
+    bool idle = cmdMode && !callConnected && !dialing && !vdriveOnline;
+
+    if (ringLine >= 0 && (!idle || !calls[ringLine].client.connected()))
+        dropCall(ringLine);
+    if (ringLine < 0 && idle && !callInUse(currentCall) && server.answer(*tcpClient))
+    {
+        IPAddress ip = tcpClient->remoteIP();
+        Call &call = calls[currentCall];
+        call.held.consume(call.held.readable());
+        call.mode = CALL_TCP;
+        call.telnet = telnet;
+        call.codec.reset();
+        call.name = String(ip[0]) + "." + String(ip[1]) + "." + String(ip[2]) + "." + String(ip[3]);
+        ringLine = currentCall;
+        rings = 0;
+        nextRing = get_absolute_time();
+    }
+    // Anyone else calling is busy
+    if (ringLine >= 0 || !idle)
+    {
+        while (server.refuse())
+            ;
+    }
+
+    if (ringLine < 0 || !time_reached(nextRing))
+        return;
+    if (rings == RING_LIMIT)
+    {
+        dropCall(ringLine);
         return;
+    }
+    sendResult(R_RING);
+    rings++;
+    nextRing = make_timeout_time_ms(RING_MS);
+    if (s0 && rings >= s0)
+        answerCall();
+}
+
+/**
+ * 2MG images have a header in front of the blocks, which start at the
+ * offset at 0x18.  The header is copied to a mirror, so it has to be all
+ * within the len bytes read, else -1
+ */
+int adtVHeaderSize(const uint8_t *start, size_t len)
+{
+    if(len < 4 || 0 != strncmp((const char*)start, "2IMG", 4))
+        return 0;
+    if(len < 0x1c)
+        return -1;
+    uint32_t offset = start[0x18] | (start[0x19] << 8) | (start[0x1a] << 16) | ((uint32_t)start[0x1b] << 24);
+    return offset <= len && offset <= VDRIVE_HEADER_SIZE ? (int)offset : -1;
+}
+
+/**
+ * Send the block the Apple II asked for, which is already at DATA_START in
+ * txBuf if read is true.  If not, the block goes out with a bad checksum so
+ * the Apple II asks again
+ */
+void adtVSend(bool read)
+{
+    const int size = 512;
+    const int DATA_START = 9;
 
     uint16_t pd_date, pd_time;
     time_t rawtime = ntp.getEpochTime();
@@ -895,23 +1439,6 @@ void adtVSend(int drive, int block)
     for(size_t i=0; i<DATA_START-1; i++)
         txBuf[DATA_START-1] ^= txBuf[i];
 
-    size_t index = 0;
-    while(index < size)
-    {
-        size_t read = smb2_pread(vdrive[drive].smb2, vdrive[drive].fh, &txBuf[DATA_START+index], size-index, offset+index);
-        if (read == -EAGAIN)
-        {
-            continue;
-        }
-
-        if (read < 0)
-        {
-            break;
-        }
-
-        index += read;
-    }
-
     // Checksum the file data
     uint8_t checksum = 0;
     for(int i=0; i<size; i++)
@@ -919,14 +1446,10 @@ void adtVSend(int drive, int block)
         checksum ^= txBuf[DATA_START+i];
     }
 
-    // If the read did not get the right number of bytes,
-    // Make it the right size but make sure the checksum fails
-    if(index < size)
-    {
-        index = size;
+    // If the read did not work, make sure the checksum fails
+    if(!read)
         checksum++;
-    }
-    index += DATA_START;
+    size_t index = DATA_START + size;
 
     // Add the file data checksup
     txBuf[index++] = checksum;
@@ -935,103 +1458,552 @@ void adtVSend(int drive, int block)
     c0tx.Write(txBuf, index);
 }
 
-void adtVRecv(int drive, int block)
-{
-    if(!vdrive[drive].mounted)
-        return;
-}
-
-void adtVOnline(byte old_serial_speed)
+/**
+ * The Apple II asked for a block.  Blocks on the SD card, an SD image or what
+ * has been mirrored so far, never touch the network and go out at once.
+ * Others are asked of the cache, and adtVPoll() sends them when they arrive
+ */
+void adtVRead(int drive, int block)
 {
-    while(1)
-    {
-        if(c0rx.readBytes(rxBuf, 1) && rxBuf[0] == 0xC5)
-        {
-            c0rx.readBytes(&rxBuf[1], 4);
-            int drive = rxBuf[1] >> 2;
-            int block = rxBuf[2] + 256 * rxBuf[3];
+    const int DATA_START = 9;
 
-            bool checksum = rxBuf[4] == rxBuf[0] ^ rxBuf[1] ^ rxBuf[2] ^ rxBuf[3];
-            if(!checksum)
-            {
-                continue;
-            }
+    vdriveBlock = block;
+    vdriveDrive = drive;
+    vdriveTimeout = make_timeout_time_ms(VDRIVE_WAIT_MS);
+    vdriveState = VS_SEND;
 
-            if(/*rxBuf[i+1] == 0x01 ||*/ rxBuf[1] == 0x03 || rxBuf[1] == 0x05)
-            {
-                adtVSend(drive, block);
-            }
-            else if(rxBuf[1] == 0x02 || rxBuf[1] == 0x04)
-            {
-                adtVRecv(drive, block);
-            }
-            else if(rxBuf[1] == 0x80)
-            {
-                break;
-            }
-        }
+    if(vdrive[drive].sd.holds(block))
+    {
+        adtVSend(vdrive[drive].sd.read(block, &txBuf[DATA_START]));
+        vdriveState = VS_SYNC;
+    }
+    else
+    {
+        vdrive[drive].cache.want(block);
     }
-#ifdef USE_UART    
-    c0cmd.Write('B');
-    c0cmd.Write(old_serial_speed);     // 8 = 115200
-#endif
 }
 
 /**
- * Use SMB to mount a disk
+ * The Apple II wrote a block - 512 bytes and their checksum are in txBuf.
+ * The block goes into the drive's write-back cache so the ack does not wait
+ * for the server.  No ack makes the Apple II try again
  */
-void adtVServeSetup(String upCmd)
+void adtVRecv(int drive, int block)
 {
-    int driveNum = upCmd.charAt(4) - '0';
-    if(driveNum == 1 || driveNum == 2)
+    const int size = 512;
+
+    uint8_t checksum = 0;
+    for(int i=0; i<size; i++)
     {
-        driveNum--;
-        if(vdrive[driveNum].mounted)
-        {
-            smb2_close(vdrive[driveNum].smb2, vdrive[driveNum].fh);
-            smb2_disconnect_share(vdrive[driveNum].smb2);
-            smb2_destroy_url(vdrive[driveNum].url);
-            smb2_destroy_context(vdrive[driveNum].smb2);
-            vdrive[driveNum].mounted = false;
-        }
-        vdrive[driveNum].smb2 = smb2_init_context();
-        if (vdrive[driveNum].smb2 == NULL)
-            goto vserror;
+        checksum ^= txBuf[i];
+    }
+    if(checksum != txBuf[size])
+        return;
 
-        upCmd.toLowerCase();
-        vdrive[driveNum].url = smb2_parse_url(vdrive[driveNum].smb2, upCmd.substring(5).c_str());
-        if (vdrive[driveNum].url == NULL)
-            goto vserror;
+    VDrive &d = vdrive[drive];
+    if(d.readOnly)
+        return;
 
-        smb2_set_security_mode(vdrive[driveNum].smb2, SMB2_NEGOTIATE_SIGNING_ENABLED);
+    // An SMB image, mirrored or not, gets the block through the cache.  The
+    // SD card gets it when it holds the block, or already has the rest.  A
+    // block that went nowhere, past the end of the image or with no image
+    // open, is not acked
+    bool written = false;
+    if(d.smb2)
+    {
+        if(!d.cache.write(block, txBuf))
+            return;
+        d.sd.changed(block);
+        written = true;
+    }
+    if(d.sd.holds(block))
+    {
+        if(d.sd.write(block, txBuf))
+            written = true;
+        else if(d.smb2)
+            d.sd.close();   // The mirror's copy is now out of date, so SMB serves
+    }
+    if(!written)
+        return;
 
-        if (smb2_connect_share(vdrive[driveNum].smb2, vdrive[driveNum].url->server, vdrive[driveNum].url->share, vdrive[driveNum].url->user) < 0)
-            goto vserror;
+    // The ack is the command envelope sent back
+    uint8_t ack[5] = {0xc5, rxBuf[1], rxBuf[2], rxBuf[3], rxBuf[4]};
+    c0tx.Write(ack, sizeof(ack));
+}
 
-        vdrive[driveNum].fh = smb2_open(vdrive[driveNum].smb2, vdrive[driveNum].url->path, O_RDONLY);
-        if (vdrive[driveNum].fh == NULL)
-            goto vserror;
+void adtVMountStep(struct smb2_context *smb2, int status, void *command_data, void *private_data);
 
-        if (smb2_fstat(vdrive[driveNum].smb2, vdrive[driveNum].fh, &vdrive[driveNum].st) < 0)
-            goto vserror;
+void adtVSessionConnected(struct smb2_context *smb2, int status, void *command_data, void *private_data)
+{
+    SMBSession &session = *(SMBSession *)private_data;
+    if(session.state == SS_CONNECTING)
+        session.state = status < 0 ? SS_FAILED : SS_CONNECTED;
+}
 
-        if(TX_BUF_SIZE != smb2_pread(vdrive[driveNum].smb2, vdrive[driveNum].fh, txBuf, TX_BUF_SIZE, 0))
-            goto vserror;
+/**
+ * The session for the share the url names.  Drives with images on the same
+ * share use the one connection.  A new session starts connecting, and
+ * adtVService() moves the drive along once it has
+ */
+SMBSession *adtVSessionGet(struct smb2_url *url)
+{
+    String user = url->user ? url->user : "";
+    SMBSession *free = NULL;
 
-        if(0 == strncmp((const char*)txBuf, "2IMG", 4))
+    for(int i=0; i<VDRIVE_MAX; i++)
+    {
+        SMBSession &session = smbSessions[i];
+        if(session.state == SS_FREE)
         {
-            vdrive[driveNum].headerSize = (txBuf[0x18]);
+            if(!free)
+                free = &session;
         }
-        else
+        else if(session.state != SS_FAILED && session.server == url->server && session.share == url->share && session.user == user)
         {
-            vdrive[driveNum].headerSize = 0;
+            session.refs++;
+            return &session;
         }
-        vdrive[driveNum].mounted = true;
-        sendResult(R_OK);
     }
-    else if (upCmd == "ATVSO")
+    if(!free)
+        return NULL;
+
+    free->smb2 = smb2_init_context();
+    if(!free->smb2)
+        return NULL;
+    smb2_set_security_mode(free->smb2, SMB2_NEGOTIATE_SIGNING_ENABLED);
+    free->server = url->server;
+    free->share = url->share;
+    free->user = user;
+    free->state = SS_CONNECTING;
+    free->refs = 1;
+    if(smb2_connect_share_async(free->smb2, url->server, url->share, url->user, adtVSessionConnected, free) < 0)
+        free->state = SS_FAILED;
+    return free;
+}
+
+/**
+ * A drive is done with the session.  The last one out disconnects it
+ */
+void adtVSessionRelease(SMBSession *session)
+{
+    if(--session->refs > 0)
+        return;
+    if(session->state == SS_CONNECTED)
+        smb2_disconnect_share(session->smb2);
+    smb2_destroy_context(session->smb2);
+    session->smb2 = NULL;
+    session->state = SS_FREE;
+}
+
+/**
+ * Release everything a drive has open, or is still opening
+ */
+void adtVUnmount(int driveNum)
+{
+    VDrive &drive = vdrive[driveNum];
+
+    drive.cache.end();
+    drive.sd.close();
+    if(drive.session)
     {
-        if(!vdrive[0].mounted && !vdrive[1].mounted)
+        // On a session that stays up, a mount step still in flight would
+        // complete into this drive after it has moved on
+        absolute_time_t timeout = make_timeout_time_ms(VDRIVE_WAIT_MS);
+        while(drive.inFlight && drive.session->refs > 1 && !time_reached(timeout))
+        {
+            if(BlockCache::serviceSMB(drive.session->smb2) < 0)
+                break;
+        }
+        if(drive.fh)
+            smb2_close(drive.smb2, drive.fh);
+        adtVSessionRelease(drive.session);
+    }
+    if(drive.url)
+        smb2_destroy_url(drive.url);
+    drive.session = NULL;
+    drive.smb2 = NULL;
+    drive.url = NULL;
+    drive.fh = NULL;
+    drive.inFlight = 0;
+    drive.state = VD_IDLE;
+    drive.mounted = false;
+}
+
+/**
+ * The drive's session is connected, so open its image
+ */
+void adtVMountOpen(VDrive &drive)
+{
+    drive.smb2 = drive.session->smb2;
+    drive.state = VD_OPEN;
+    if(smb2_open_async(drive.smb2, drive.url->path, O_RDWR, adtVMountStep, &drive) < 0)
+        drive.state = VD_FAILED;
+    else
+        drive.inFlight++;
+}
+
+/**
+ * Each step of mounting an SMB image, once the session is connected,
+ * completes here and starts the next: open (read/write, else read only),
+ * fstat, read the header
+ */
+void adtVMountStep(struct smb2_context *smb2, int status, void *command_data, void *private_data)
+{
+    VDrive &drive = *(VDrive *)private_data;
+    int rc = -1;
+
+    if(drive.inFlight)
+        drive.inFlight--;
+    switch(drive.state)
+    {
+        case VD_OPEN:
+        case VD_OPEN_RO:
+            if(status < 0)
+            {
+                // Images the share will not let us write are still served, read only
+                if(drive.state == VD_OPEN)
+                {
+                    drive.state = VD_OPEN_RO;
+                    rc = smb2_open_async(smb2, drive.url->path, O_RDONLY, adtVMountStep, &drive);
+                }
+                break;
+            }
+            drive.fh = (struct smb2fh *)command_data;
+            drive.readOnly = drive.state == VD_OPEN_RO;
+            drive.state = VD_FSTAT;
+            rc = smb2_fstat_async(smb2, drive.fh, &drive.st, adtVMountStep, &drive);
+            break;
+
+        case VD_FSTAT:
+            if(status < 0)
+                break;
+            drive.state = VD_HEADER;
+            rc = smb2_pread_async(smb2, drive.fh, drive.header, VDRIVE_HEADER_SIZE, 0, adtVMountStep, &drive);
+            break;
+
+        case VD_HEADER:
+            if(status < 0)
+                break;
+            // A header bigger than VDRIVE_HEADER_SIZE is not one this can serve
+            drive.headerSize = adtVHeaderSize(drive.header, status);
+            if(drive.headerSize < 0)
+                break;
+            drive.state = VD_READY;
+            return;
+
+        default:
+            return;
+    }
+
+    if(rc < 0)
+        drive.state = VD_FAILED;
+    else
+        drive.inFlight++;
+}
+
+/**
+ * An SMB mount finished, successfully or not, so report it
+ */
+void adtVMountDone(int driveNum)
+{
+    VDrive &drive = vdrive[driveNum];
+
+    // The cache is only given its RAM now, while the drive is mounted
+    if(drive.state != VD_READY || !drive.cache.begin(drive.smb2, drive.fh, drive.headerSize, drive.st.smb2_size, !drive.readOnly))
+    {
+        adtVUnmount(driveNum);
+        sendResult(R_ERROR);
+        return;
+    }
+    drive.cache.setFlushPolicy(vdriveFlush);
+
+    // Copy the image to the mirror folder on the SD card, under the same
+    // name, in the background.  Not if another drive has that file open.  If
+    // it can not be copied, SMB serves every block
+    if(vdriveMirror && sd_init_driver)
+    {
+        String path = drive.url->path;
+        String name = SDIMAGE_MIRROR_DIR "/" + path.substring(path.lastIndexOf('/') + 1);
+        bool taken = false;
+        for(int i=0; i<VDRIVE_MAX; i++)
+            taken |= vdrive[i].sd.uses(name.c_str());
+        if(!taken)
+            drive.sd.mirror(name.c_str(), &drive.cache, drive.smb2, drive.fh, drive.header, drive.headerSize, drive.st.smb2_size);
+    }
+
+    drive.state = VD_MOUNTED;
+    drive.mounted = true;
+    sendResult(R_OK);
+}
+
+/**
+ * Called every time through loop().  Moves mounts, SMB reads and writes
+ * along, and copies more of any mirror.  Never waits on the network
+ */
+void adtVService()
+{
+    // Sessions still connecting have no drive with requests in flight
+    for(int i=0; i<VDRIVE_MAX; i++)
+    {
+        SMBSession &session = smbSessions[i];
+        if(session.state == SS_CONNECTING && BlockCache::serviceSMB(session.smb2) < 0)
+            session.state = SS_FAILED;
+    }
+
+    for(int i=0; i<VDRIVE_MAX; i++)
+    {
+        VDrive &drive = vdrive[i];
+
+        if(drive.state == VD_CONNECT)
+        {
+            if(drive.session->state == SS_CONNECTED)
+                adtVMountOpen(drive);
+            else if(drive.session->state == SS_FAILED)
+                drive.state = VD_FAILED;
+        }
+        if(drive.state >= VD_CONNECT && drive.state <= VD_HEADER)
+        {
+            if(time_reached(drive.mountTimeout) || (drive.inFlight && BlockCache::serviceSMB(drive.smb2) < 0))
+                drive.state = VD_FAILED;
+        }
+        if(drive.state == VD_READY || drive.state == VD_FAILED)
+            adtVMountDone(i);
+
+        if(drive.mounted)
+        {
+            drive.cache.service();
+            drive.sd.service();
+        }
+    }
+}
+
+/**
+ * The Apple II took the drives offline
+ */
+void adtVOffline()
+{
+    // Whatever the flush policy, nothing is left unwritten when going offline
+    for(int i=0; i<VDRIVE_MAX; i++)
+    {
+        vdrive[i].cache.flush();
+        vdrive[i].sd.sync();
+    }
+    vdriveOnline = false;
+#ifdef USE_UART    
+    c0cmd.Write('B');
+    c0cmd.Write(vdriveSerialSpeed);
+#endif
+}
+
+/**
+ * Called every time through loop() while the drives are online.  Commands
+ * from the Apple II are taken as their bytes arrive, and a block read is
+ * answered when its data is in, so nothing here blocks and the rest of
+ * loop() keeps running
+ */
+void adtVPoll()
+{
+    const int size = 512;
+    const int DATA_START = 9;
+
+    switch(vdriveState)
+    {
+        case VS_SYNC:
+            // Everything up to the start of a command is dropped
+            while(c0rx.available())
+            {
+                rxBuf[0] = c0rx.Read();
+                if(rxBuf[0] == 0xC5)
+                {
+                    vdriveState = VS_COMMAND;
+                    vdriveTimeout = make_timeout_time_ms(VDRIVE_BYTE_MS);
+                    break;
+                }
+            }
+            break;
+
+        case VS_COMMAND:
+            if(c0rx.available() >= 4)
+            {
+                c0rx.Read(&rxBuf[1], 4);
+                // 0x02 + 2 * unit is a write and 0x03 + 2 * unit a read
+                int drive = (rxBuf[1] - 2) >> 1;
+                int block = rxBuf[2] + 256 * rxBuf[3];
+                vdriveState = VS_SYNC;
+                led_set(true);
+
+                bool checksum = rxBuf[4] == (rxBuf[0] ^ rxBuf[1] ^ rxBuf[2] ^ rxBuf[3]);
+                if(!checksum)
+                    break;
+
+                if(rxBuf[1] == 0x80)
+                {
+                    adtVOffline();
+                }
+                else if(rxBuf[1] < 0x02 || drive >= VDRIVE_MAX || !vdrive[drive].mounted)
+                {
+                    break;
+                }
+                else if(rxBuf[1] & 1)
+                {
+                    adtVRead(drive, block);
+                }
+                else
+                {
+                    vdriveDrive = drive;
+                    vdriveBlock = block;
+                    vdriveState = VS_DATA;
+                    vdriveTimeout = make_timeout_time_ms(VDRIVE_BYTE_MS);
+                }
+            }
+            else if(time_reached(vdriveTimeout))
+            {
+                vdriveState = VS_SYNC;
+            }
+            break;
+
+        case VS_DATA:
+            // The block and its checksum fit in c0rx, so wait for all of it
+            if(c0rx.available() >= size + 1)
+            {
+                c0rx.Read(txBuf, size + 1);
+                adtVRecv(vdriveDrive, vdriveBlock);
+                vdriveState = VS_SYNC;
+            }
+            else if(time_reached(vdriveTimeout))
+            {
+                vdriveState = VS_SYNC;
+            }
+            break;
+
+        case VS_SEND:
+            if(vdrive[vdriveDrive].cache.fetch(vdriveBlock, &txBuf[DATA_START], false))
+            {
+                adtVSend(true);
+                vdriveState = VS_SYNC;
+            }
+            else if(time_reached(vdriveTimeout))
+            {
+                adtVSend(false);
+                vdriveState = VS_SYNC;
+            }
+            break;
+    }
+
+#ifdef PRODOS_FIRMWARE
+    // Once the driver's command is answered, the card is the modem again
+    if(vdriveFrame && vdriveState == VS_SYNC)
+    {
+        vdriveFrame = false;
+        vdriveOnline = false;
+    }
+#endif
+}
+
+/**
+ * Mount an sd:/path image, which needs no network so is done at once
+ */
+bool adtVMountSD(VDrive &drive, String path)
+{
+    if(!sd_init_driver || FR_OK != drive.sd.open(("0:" + path.substring(3)).c_str()))
+        return false;
+    drive.headerSize = adtVHeaderSize(drive.header, drive.sd.readAt(0, drive.header, VDRIVE_HEADER_SIZE));
+    if(drive.headerSize < 0)
+    {
+        drive.sd.close();
+        return false;
+    }
+    drive.sd.setHeaderSize(drive.headerSize);
+    drive.readOnly = !drive.sd.canWrite();
+    drive.state = VD_MOUNTED;
+    drive.mounted = true;
+    return true;
+}
+
+/**
+ * Use SMB, or the SD card, to mount a disk
+ */
+void adtVServeSetup(String upCmd)
+{
+    int driveNum = upCmd.charAt(4) - '0';
+    if(driveNum >= 1 && driveNum <= VDRIVE_MAX)
+    {
+        driveNum--;
+        VDrive &drive = vdrive[driveNum];
+        if(drive.state != VD_IDLE)
+            adtVUnmount(driveNum);
+
+        upCmd.toLowerCase();
+        String path = upCmd.substring(5);
+
+        // sd:/path is an image on the SD card, served without the network
+        if(path.indexOf("sd:") == 0)
+        {
+            if(!adtVMountSD(drive, path))
+                goto vserror;
+            sendResult(R_OK);
+            return;
+        }
+
+        {
+            // The url does not belong to the context that parsed it
+            struct smb2_context *parser = smb2_init_context();
+            if (parser == NULL)
+                goto vserror;
+            drive.url = smb2_parse_url(parser, path.c_str());
+            smb2_destroy_context(parser);
+        }
+        if (drive.url == NULL)
+            goto vserror;
+
+        drive.session = adtVSessionGet(drive.url);
+        if (drive.session == NULL)
+            goto vserror;
+
+        // The mount goes on in the background, and adtVService() sends the
+        // OK or ERROR when it is done
+        drive.state = VD_CONNECT;
+        drive.mountTimeout = make_timeout_time_ms(VDRIVE_MOUNT_MS);
+    }
+    else if (upCmd.indexOf("ATVSM") == 0)
+    {
+        if(upCmd == "ATVSM0" || upCmd == "ATVSM1")
+        {
+            vdriveMirror = upCmd.charAt(5) == '1';
+            sendResult(R_OK);
+        }
+        else
+        {
+            sendResult(R_ERROR);
+        }
+    }
+    else if (upCmd.indexOf("ATVSW") == 0)
+    {
+        // 0 = write through, 1 = write back when idle, 2 = write back when going offline
+        int policy = upCmd.charAt(5) - '0';
+        if(upCmd.length() == 6 && policy >= BlockCache::FLUSH_THROUGH && policy <= BlockCache::FLUSH_EXIT)
+        {
+            vdriveFlush = (BlockCache::FlushPolicy)policy;
+            for(int i=0; i<VDRIVE_MAX; i++)
+                vdrive[i].cache.setFlushPolicy(vdriveFlush);
+            sendResult(R_OK);
+        }
+        else
+        {
+            sendResult(R_ERROR);
+        }
+    }
+    else if (upCmd == "ATVSO")
+    {
+        // Not while a mount has yet to report its result
+        bool mounting = false, mounted = false;
+        for(int i=0; i<VDRIVE_MAX; i++)
+        {
+            mounting |= vdrive[i].state != VD_IDLE && vdrive[i].state != VD_MOUNTED;
+            mounted |= vdrive[i].mounted;
+        }
+
+        if(!mounted || mounting)
         {
             sendResult(R_ERROR);
         }
@@ -1041,7 +2013,10 @@ void adtVServeSetup(String upCmd)
             c0cmd.Write('B');
             c0cmd.Write(8);     // 8 = 115200
 #endif        
-            adtVOnline(serialspeed);
+            // loop() now hands the serial data to adtVPoll()
+            vdriveSerialSpeed = serialspeed;
+            vdriveState = VS_SYNC;
+            vdriveOnline = true;
         }
     }
     else
@@ -1051,10 +2026,7 @@ void adtVServeSetup(String upCmd)
     return;
 
 vserror:
-    smb2_close(vdrive[driveNum].smb2, vdrive[driveNum].fh);
-    smb2_disconnect_share(vdrive[driveNum].smb2);
-    smb2_destroy_url(vdrive[driveNum].url);
-    smb2_destroy_context(vdrive[driveNum].smb2);
+    adtVUnmount(driveNum);
     sendResult(R_ERROR);
 }
 
@@ -1098,6 +2070,18 @@ void command()
         sendResult(R_OK);
     }
 
+    /**** Change roaming between access points ****/
+    else if (upCmd == "ATROAM0")
+    {
+        WiFi.roaming = false;
+        sendResult(R_OK);
+    }
+    else if (upCmd == "ATROAM1")
+    {
+        WiFi.roaming = true;
+        sendResult(R_OK);
+    }
+
     /**** Display Help ****/
     else if (upCmd == "AT?" || upCmd == "ATHELP")
     {
@@ -1195,6 +2179,12 @@ void command()
 
     }
 
+    /**** Set the baud rate from the next AT ****/
+    else if (upCmd == "AT$SB=A")
+    {
+        setAutoBaud();
+    }
+
     /**** Set current baud rate ****/
     else if (upCmd.indexOf("AT$SB=") == 0)
     {
@@ -1204,8 +2194,7 @@ void command()
     /**** Display current baud rate ****/
     else if (upCmd.indexOf("AT$SB?") == 0)
     {
-        sendString(String(bauds[serialspeed]));
-        ;
+        sendString(String(bauds[serialspeed]) + (autobaud ? " AUTO" : ""));
     }
 
     /**** Display Network settings ****/
@@ -1320,6 +2309,44 @@ void command()
         sendResult(R_OK);
     }
 
+    /**** Make a new SSH key, and show its public half ****/
+    else if (upCmd == "AT$SSHKEYGEN")
+    {
+        String key;
+        c0tx.println("MAKING KEY...");
+        if (SSHKey::generate(key) && SSHKey::load(key))
+        {
+            ssh_key = key;
+            sendString(SSHKey::publicKeyLine("modem"));
+            sendResult(R_OK);
+        }
+        else
+        {
+            SSHKey::load(ssh_key);
+            sendResult(R_ERROR);
+        }
+    }
+
+    /**** Display the SSH public key, for a server's authorized_keys ****/
+    else if (upCmd == "AT$SSHKEY?")
+    {
+        if (SSHKey::loaded())
+        {
+            sendString(SSHKey::publicKeyLine("modem"));
+            sendResult(R_OK);
+        }
+        else
+            sendResult(R_ERROR);
+    }
+
+    /**** Forget the SSH key and log in with the password ****/
+    else if (upCmd == "AT$SSHKEYDEL")
+    {
+        ssh_key = "";
+        SSHKey::load(ssh_key);
+        sendResult(R_OK);
+    }
+
     /**** Reset current memory settings to factory defaults ****/
     else if (upCmd == "AT&F")
     {
@@ -1341,17 +2368,34 @@ void command()
         sendResult(R_OK);
     }
 
-    /**** Hang up a call ****/
+    /**** Hang up the call on the terminal, or call n with ATHn ****/
     else if (upCmd.indexOf("ATH") == 0)
     {
-        hangUp();
+        int n = currentCall;
+        if (upCmd.length() == 4 && upCmd[3] >= '1' && upCmd[3] < '1' + MAX_CALLS)
+            n = upCmd[3] - '1';
+        if (n == currentCall)
+        {
+            hangUp();
+        }
+        else if (callInUse(n))
+        {
+            dropCall(n);
+            sendResult(R_OK);
+        }
+        else
+        {
+            sendResult(R_ERROR);
+        }
     }
 
-    /**** Exit modem command mode, go online ****/
-    else if (upCmd == "ATO")
+    /**** Exit modem command mode, go online, to call n with ATOn ****/
+    else if (upCmd == "ATO" || (upCmd.length() == 4 && upCmd.indexOf("ATO") == 0 && upCmd[3] >= '1' && upCmd[3] < '1' + MAX_CALLS))
     {
-        if (callConnected == 1)
+        int n = upCmd.length() == 4 ? upCmd[3] - '1' : currentCall;
+        if (callInUse(n))
         {
+            switchCall(n);
             sendResult(R_CONNECT);
             cmdMode = false;
         }
@@ -1366,9 +2410,11 @@ void command()
     else if (upCmd.indexOf("ATGET") == 0)
     {
         // From the URL, aquire required variables
-        // (12 = "ATGEThttp://")
-        int portIndex = cmd.indexOf(":", 12); // Index where port number might begin
-        int pathIndex = cmd.indexOf("/", 12); // Index first host name and possible port ends and path begins
+        // (12 = "ATGEThttp://", 13 = "ATGEThttps://")
+        bool https = upCmd.indexOf("ATGETHTTPS://") == 0;
+        int hostIndex = https ? 13 : 12;
+        int portIndex = cmd.indexOf(":", hostIndex); // Index where port number might begin
+        int pathIndex = cmd.indexOf("/", hostIndex); // Index first host name and possible port ends and path begins
         int port;
         String path, host;
         if (pathIndex < 0)
@@ -1377,21 +2423,26 @@ void command()
         }
         if (portIndex < 0)
         {
-            port = 80;
+            port = https ? 443 : 80;
             portIndex = pathIndex;
         }
         else
         {
             port = cmd.substring(portIndex + 1, pathIndex).toInt();
         }
-        host = cmd.substring(12, portIndex);
+        host = cmd.substring(hostIndex, portIndex);
         path = cmd.substring(pathIndex, cmd.length());
         if (path == "")
             path = "/";
 
-        // Establish connection
-        if (!tcpClient.tcp_connect(host.c_str(), port))
+        // Establish connection, on a line of its own
+        if (!newCall(host + ":" + port, https ? CALL_TLS : CALL_TCP, false))
+        {
+            sendResult(R_ERROR);
+        }
+        else if (!tcpClient->tcp_connect(host.c_str(), port) || (https && !tcpClient->tls_connect(host.c_str())))
         {
+            tcpClient->stop();
             sendResult(R_NOCARRIER);
             callConnected = false;
         }
@@ -1408,7 +2459,7 @@ void command()
             request += " HTTP/1.1\r\nHost: ";
             request += host;
             request += "\r\nConnection: close\r\n\r\n";
-            tcpClient.print(request);
+            tcpClient->print(request);
         }
     }
 
@@ -1439,8 +2490,12 @@ void command()
         if (path == "")
             path = "/";
 
-        // Establish connection
-        if (!tcpClient.tcp_connect(host.c_str(), port))
+        // Establish connection, on a line of its own
+        if (!newCall(host + ":" + port, CALL_TCP, false))
+        {
+            sendResult(R_ERROR);
+        }
+        else if (!tcpClient->tcp_connect(host.c_str(), port))
         {
             sendResult(R_NOCARRIER);
             callConnected = false;
@@ -1451,7 +2506,85 @@ void command()
             connectTime = get_absolute_time();
             cmdMode = false;
             callConnected = true;
-            tcpClient.print(path + "\r\n");
+            tcpClient->print(path + "\r\n");
+        }
+    }
+
+    /**** Answer a call that is ringing ****/
+    else if (upCmd == "ATA")
+    {
+        if (ringLine >= 0)
+            answerCall();
+        else
+            sendResult(R_ERROR);
+    }
+
+    /**** RINGs before answering ****/
+    else if (upCmd.indexOf("ATS0") == 0)
+    {
+        if (upCmd.substring(4, 5) == "?")
+        {
+            sendString(String(s0));
+            sendResult(R_OK);
+        }
+        else if (upCmd.substring(4, 5) == "=" && upCmd.substring(5).toInt() >= 0 && upCmd.substring(5).toInt() <= 255)
+        {
+            s0 = upCmd.substring(5).toInt();
+            sendResult(R_OK);
+        }
+        else
+        {
+            sendResult(R_ERROR);
+        }
+    }
+
+    /**** Port to listen on for calls ****/
+    else if (upCmd.indexOf("AT$SP=") == 0)
+    {
+        int port = upCmd.substring(6).toInt();
+        if (port < 0 || port > 65535)
+        {
+            sendResult(R_ERROR);
+        }
+        else
+        {
+            listenPort = port;
+            server.stop();
+            if (listenPort && WiFi.status() == CYW43_LINK_UP && !server.begin(listenPort))
+                sendResult(R_ERROR);
+            else
+                sendResult(R_OK);
+        }
+    }
+    else if (upCmd == "AT$SP?")
+    {
+        sendString(String(listenPort));
+        sendResult(R_OK);
+    }
+
+    /**** List the calls ****/
+    else if (upCmd == "AT$CALL?")
+    {
+        displayCalls();
+        sendResult(R_OK);
+    }
+
+    /**** Seconds to wait for a host to answer ****/
+    else if (upCmd.indexOf("ATS7") == 0)
+    {
+        if (upCmd.substring(4, 5) == "?")
+        {
+            sendString(String(s7));
+            sendResult(R_OK);
+        }
+        else if (upCmd.substring(4, 5) == "=" && upCmd.substring(5).toInt() >= 1 && upCmd.substring(5).toInt() <= 255)
+        {
+            s7 = upCmd.substring(5).toInt();
+            sendResult(R_OK);
+        }
+        else
+        {
+            sendResult(R_ERROR);
         }
     }
 
@@ -1499,8 +2632,22 @@ void loop()
         {
             ntp.update();
         }
+        // Move to a stronger AP of the same network if the signal fades
+        WiFi.roam();
+        // Keep VSDrive mounts, reads, write backs and mirrors going
+        adtVService();
+        /**** VSDrive online - the serial data is for the virtual drives ****/
+        if (vdriveOnline)
+        {
+            adtVPoll();
+        }
+        /**** Dialing - waiting for the host to answer ****/
+        else if (dialing)
+        {
+            dialPoll();
+        }
         /**** AT command mode ****/
-        if (cmdMode == true)
+        else if (cmdMode == true)
         {
             // In command mode - don't exchange with TCP but gather characters to a string
             if (c0rx.available())
@@ -1508,6 +2655,19 @@ void loop()
                 led_set(true);
                 char chr = c0rx.Read();
 
+#ifdef PRODOS_FIRMWARE
+                // The card's ProDOS driver shares the data register with
+                // the AT commands, and 0xC5 can't be typed into a command
+                if ((byte)chr == 0xC5)
+                {
+                    vdriveFrame = true;
+                    vdriveOnline = true;
+                    vdriveState = VS_COMMAND;
+                    vdriveTimeout = make_timeout_time_ms(VDRIVE_BYTE_MS);
+                    rxBuf[0] = chr;
+                }
+                else
+#endif
                 // Return, enter, new line, carriage return.. anything goes to end the command
                 if ((chr == '\n') || (chr == '\r'))
                 {
@@ -1540,28 +2700,28 @@ void loop()
         /**** Connected mode ****/
         else
         {
-            // Transmit from terminal to TCP
-            if (c0rx.available())
+            // Transmit from terminal to TCP, straight from the contiguous
+            // readable region of c0rx
+            const uint8_t *rxSpan;
+            size_t len = c0rx.read_span(&rxSpan);
+            if (len)
             {
                 led_set(true);
+                const uint8_t *txData = rxSpan;
+                size_t txLen = len;
 
-                // In telnet in worst case we have to escape every byte
-                // so leave half of the buffer always free
-                int max_buf_size;
-                if (telnet == true)
-                    max_buf_size = TX_BUF_SIZE / 2;
-                else
-                    max_buf_size = TX_BUF_SIZE;
-
-                // Read from serial, the amount available up to
-                // maximum size of the buffer
-                size_t len = min(c0rx.available(), max_buf_size);
-                c0rx.readBytes(&txBuf[0], len);
+                // In telnet every 0xff is doubled into txBuf, which may not hold
+                // all of the span, so only what got escaped is consumed
+                if (calls[currentCall].telnet)
+                {
+                    txLen = telnetCodec->escape(rxSpan, len, txBuf, TX_BUF_SIZE, &len);
+                    txData = txBuf;
+                }
 
                 // Enter command mode with "+++" sequence
                 for (int i = 0; i < (int)len; i++)
                 {
-                    if (txBuf[i] == '+')
+                    if (rxSpan[i] == '+')
                     {
                         plusCount++;
                         if (plusCount >= 3)
@@ -1575,70 +2735,40 @@ void loop()
                     }
                 }
 
-                // Double (escape) every 0xff for telnet, shifting the following bytes
-                // towards the end of the buffer from that point
-                if (telnet == true)
-                {
-                    for (int i = len - 1; i >= 0; i--)
-                    {
-                        if (txBuf[i] == 0xff)
-                        {
-                            for (int j = TX_BUF_SIZE - 1; j > i; j--)
-                            {
-                                txBuf[j] = txBuf[j - 1];
-                            }
-                            len++;
-                        }
-                    }
-                }
-                tcpClient.Write(&txBuf[0], len);
+                tcpClient->Write(txData, txLen);
+                c0rx.consume(len);
             }
 
-            // Transmit from TCP to terminal
-            while (tcpClient.available())
+            // Play back what the call held while it was off the terminal,
+            // ahead of anything newer from its host
+            RingBuffer &held = calls[currentCall].held;
+            uint8_t *span;
+            size_t spanSize;
+            const uint8_t *heldSpan;
+            size_t heldLen;
+            while ((heldLen = held.read_span(&heldSpan)) && (spanSize = c0tx.write_span(&span)))
             {
+                if (heldLen > spanSize)
+                    heldLen = spanSize;
+                memcpy(span, heldSpan, heldLen);
+                c0tx.commit(heldLen);
+                held.consume(heldLen);
                 led_set(true);
-                uint8_t rxByte = tcpClient.Read();
+            }
 
-                // Is a telnet control code starting?
-                if ((telnet == true) && (rxByte == 0xff))
-                {
-                    rxByte = tcpClient.Read();
-                    if (rxByte == 0xff)
-                    {
-                        // 2 times 0xff is just an escaped real 0xff
-                        c0tx.Write(0xff);
-                        // c0tx.flush();
-                    }
-                    else
-                    {
-                        // rxByte has now the first byte of the actual non-escaped control code
-                        uint8_t cmdByte1 = rxByte;
-                        rxByte = tcpClient.Read();
-                        uint8_t cmdByte2 = rxByte;
-                        // rxByte has now the second byte of the actual non-escaped control code
-                        // We are asked to do some option, respond we won't
-                        if (cmdByte1 == DO)
-                        {
-                            tcpClient.Write((uint8_t)255);
-                            tcpClient.Write((uint8_t)WONT);
-                            tcpClient.Write(cmdByte2);
-                        }
-                        // Server wants to do any option, allow it
-                        else if (cmdByte1 == WILL)
-                        {
-                            tcpClient.Write((uint8_t)255);
-                            tcpClient.Write((uint8_t)DO);
-                            tcpClient.Write(cmdByte2);
-                        }
-                    }
-                }
-                else
-                {
-                    // Non-control codes pass through freely
-                    c0tx.Write(rxByte);
-                    // c0tx.flush();
-                }
+            // Transmit from TCP to terminal - receive straight into the free
+            // contiguous region of c0tx, filter telnet codes in place, then commit
+            while (held.is_empty() && tcpClient->available() > 0 && (spanSize = c0tx.write_span(&span)))
+            {
+                int len = tcpClient->Read(span, spanSize);
+                if (len <= 0)
+                    break;
+                if (firstByteUs < 0 && !is_nil_time(dialTime))
+                    firstByteUs = absolute_time_diff_us(dialTime, get_absolute_time());
+                led_set(true);
+                if (calls[currentCall].telnet)
+                    len = telnetCodec->decode(span, len, span);
+                c0tx.commit(len);
             }
         }
 
@@ -1654,8 +2784,28 @@ void loop()
             }
         }
 
-        // Go to command mode if TCP disconnected and not in command mode
-        if (!tcpClient.connected() && cmdMode == false && callConnected == true)
+#ifdef USE_PIO
+        // Software on the Apple II dropping DTR hangs up, as with AT&D2
+        static uint32_t dtrDrops = CoreBUS::dtrDrops;
+        if (dtrDrops != CoreBUS::dtrDrops)
+        {
+            dtrDrops = CoreBUS::dtrDrops;
+            if (callConnected)
+            {
+                hangUp();
+                cmdMode = true;
+            }
+        }
+#endif
+
+        // Keep the hosts of the calls off the terminal sending
+        holdCalls();
+        // and let callers in
+        ringPoll();
+
+        // Go to command mode if TCP disconnected, and all it sent has been
+        // seen, and not in command mode
+        if (!tcpClient->connected() && calls[currentCall].held.is_empty() && cmdMode == false && callConnected == true)
         {
             hangUp();
             cmdMode = true;
@@ -1675,8 +2825,29 @@ void loop()
  */
 void pico_modem_main()
 {
-    vdrive[0].mounted = vdrive[1].mounted = false;
+    for (int i = 0; i < VDRIVE_MAX; i++)
+    {
+        vdrive[i].mounted = false;
+        vdrive[i].state = VD_IDLE;
+        smbSessions[i].state = SS_FREE;
+    }
+    for (int i = 0; i < MAX_CALLS; i++)
+    {
+        calls[i].codec.begin(&calls[i].client);
+        calls[i].connected = false;
+        calls[i].connectTime = nil_time;
+    }
 
+#ifdef PRODOS_FIRMWARE
+    // Images on the SD card are there when the Apple II boots from the card
+    for (int i = 0; i < 2; i++)
+    {
+        String path = VDRIVE_BOOT_IMAGE;
+        path += i + 1;
+        path += ".po";
+        adtVMountSD(vdrive[i], path);
+    }
+#endif
     welcome();
     loop();
 }
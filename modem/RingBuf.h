@@ -1,28 +1,132 @@
+#ifndef ringbuf_h
+#define ringbuf_h
+
+#include <atomic>
+#include <string.h>
+#include <hardware/sync.h>
 #include "Stream.h"
 
 /*
- * Circular buffer class for uart rx/tx
- * The class has no over/under-flow protection
+ * Lock-free single producer / single consumer byte queue for moving data
+ * between core 0 and core 1.  Exactly one core may write (put/Write/commit)
+ * and exactly one core may read (get/advance/Read/consume).
+ *
+ * head and tail are free running counters - only the producer stores head
+ * and only the consumer stores tail.  The store-release of an index pairs
+ * with the load-acquire on the other core so the bytes are visible before
+ * the index that publishes them.
+ *
+ * The capacity is rounded up to a power of two so wrapping is a mask.
+ * write_span/commit and read_span/consume expose the contiguous region up to
+ * the wrap point so whole blocks can be moved with a single memcpy.
+ *
+ * Every store of an index also rings a doorbell (SEV), so a core sleeping in
+ * WFE until the other core has given it data, or room, wakes up.
  */
 class RingBuffer : public Stream
 {
 private:
-    static const int size = 512+11; // 1 VSDrive block plus header bytes
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+    size_t mask;
+    uint8_t *buffer;
+
+    static size_t round_pow2(size_t size) { size_t s = 2; while(s < size) s <<= 1; return s;}
 
 public:
-    volatile size_t head = 0;
-    volatile size_t tail = 0;
-    unsigned char buffer[size];
-
-    inline bool is_empty() { return head == tail;}
-    inline bool is_full() { size_t next_head = head + 1; if(next_head == size) {next_head = 0;} return next_head == tail;}
-    inline void put(unsigned char byte) { buffer[head] = byte; if(++head == size) head = 0;}
-    inline int  get() { return buffer[tail];}
-    inline void advance() { if(++tail == size) tail = 0;}
-
-    inline virtual int available() { return head != tail;}
-    inline virtual int Read() { int c = -1; if(available()) {c= get(); advance();} return c;}
-    inline virtual int peek() { return is_empty() ? -1 : buffer[tail];}
+    RingBuffer(size_t capacity = 1024) : head(0), tail(0), mask(round_pow2(capacity) - 1), buffer(new uint8_t[mask + 1]) { ; }
+    ~RingBuffer() { delete [] buffer;}
+
+    inline size_t capacity() const { return mask + 1;}
+    // Bytes the consumer can read / the producer can write
+    inline size_t readable() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);}
+    inline size_t writable() const { return capacity() - (head.load(std::memory_order_relaxed) - tail.load(std::memory_order_acquire));}
+
+    inline bool is_empty() const { return readable() == 0;}
+    inline bool is_full() const { return writable() == 0;}
+
+    // Producer side - single byte, no over-flow protection
+    inline void put(unsigned char byte) { size_t h = head.load(std::memory_order_relaxed); buffer[h & mask] = byte; head.store(h + 1, std::memory_order_release); __sev();}
+    // Consumer side - get() is valid only if !is_empty() (else it returns a stale byte), advance() consumes it
+    inline int  get() const { return buffer[tail.load(std::memory_order_relaxed) & mask];}
+    inline void advance() { tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); __sev();}
+
+    /*
+     * Producer: point span at the contiguous free region and return its length.
+     * Fill up to that many bytes, then commit() the number actually written.
+     */
+    inline size_t write_span(uint8_t **span)
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t free = capacity() - (h - tail.load(std::memory_order_acquire));
+        size_t to_end = capacity() - (h & mask);
+        *span = &buffer[h & mask];
+        return free < to_end ? free : to_end;
+    }
+    inline void commit(size_t count) { head.store(head.load(std::memory_order_relaxed) + count, std::memory_order_release); __sev();}
+
+    /*
+     * Consumer: point span at the contiguous readable region and return its length.
+     * Use up to that many bytes, then consume() the number actually used.
+     */
+    inline size_t read_span(const uint8_t **span)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t used = head.load(std::memory_order_acquire) - t;
+        size_t to_end = capacity() - (t & mask);
+        *span = &buffer[t & mask];
+        return used < to_end ? used : to_end;
+    }
+    inline void consume(size_t count) { tail.store(tail.load(std::memory_order_relaxed) + count, std::memory_order_release); __sev();}
+
+    /*
+     * Copy as much as is available, up to size, into dest.  Never blocks.
+     * Returns the number of bytes copied.
+     */
+    size_t Read(uint8_t *dest, size_t size)
+    {
+        size_t copied = 0;
+        while(copied < size)
+        {
+            const uint8_t *span;
+            size_t len = read_span(&span);
+            if(!len)
+                break;
+            if(len > size - copied)
+                len = size - copied;
+            memcpy(&dest[copied], span, len);
+            consume(len);
+            copied += len;
+        }
+        return copied;
+    }
+
+    inline virtual int available() { return (int)readable();}
+    inline virtual int Read() { int c = -1; if(!is_empty()) {c = get(); advance();} return c;}
+    inline virtual int peek() { return is_empty() ? -1 : get();}
     inline virtual size_t Write(uint8_t c) { while(is_full()){;} put(c); return 1;}
-    inline virtual size_t Write(const uint8_t *buffer, size_t size) { size_t s = size; while(s--) {while(is_full()){;} put(*buffer++);} return size;}
+
+    /*
+     * Copy all of src into the queue, a contiguous span at a time.
+     * Blocks while the queue is full, waiting for the consumer to drain it.
+     */
+    virtual size_t Write(const uint8_t *src, size_t size)
+    {
+        size_t copied = 0;
+        while(copied < size)
+        {
+            uint8_t *span;
+            size_t len = write_span(&span);
+            if(!len)
+                continue;
+            if(len > size - copied)
+                len = size - copied;
+            memcpy(span, &src[copied], len);
+            commit(len);
+            copied += len;
+        }
+        return size;
+    }
 };
+
+#endif // ringbuf_h
@@ -0,0 +1,296 @@
+/*
+  SDImage.cpp - disk image on the SD card, served block by block
+  Stefan Wessels, 2023
+*/
+#include <stdlib.h>
+#include <string.h>
+#include "pico/time.h"
+#include <smb2/smb2.h>
+#include <smb2/libsmb2.h>
+#include "SDImage.h"
+
+#define SDIMAGE_WAIT_MS 5000    // Longest wait for a mirror's read when closing
+
+FATFS SDImage::fs;
+bool SDImage::fsMounted = false;
+
+/**
+ * All images share the one volume.  Mounting it again for every file would
+ * invalidate the files already open on it
+ */
+FRESULT SDImage::mount()
+{
+    if (fsMounted)
+        return FR_OK;
+    FRESULT fr = f_mount(&fs, "0:", 1);
+    fsMounted = fr == FR_OK;
+    return fr;
+}
+
+/**
+ * Build the cluster link map.  When the file is in too many pieces for it,
+ * seeks fall back to following the FAT
+ */
+void SDImage::fastSeek()
+{
+#if FF_USE_FASTSEEK
+    fil.cltbl = clmt;
+    clmt[0] = SDIMAGE_CLMT_SIZE;
+    if (f_lseek(&fil, CREATE_LINKMAP) != FR_OK)
+        fil.cltbl = NULL;
+#endif
+}
+
+FRESULT SDImage::open(const char *path)
+{
+    close();
+    FRESULT fr = mount();
+    if (fr != FR_OK)
+        return fr;
+    if (strlen(path) >= SDIMAGE_PATH_MAX)
+        return FR_INVALID_NAME;
+
+    writable = true;
+    fr = f_open(&fil, path, FA_READ | FA_WRITE);
+    if (fr == FR_DENIED || fr == FR_WRITE_PROTECTED)
+    {
+        writable = false;
+        fr = f_open(&fil, path, FA_READ);
+    }
+    if (fr != FR_OK)
+        return fr;
+
+    strcpy(this->path, path);
+    isOpen = true;
+    fastSeek();
+    setHeaderSize(0);
+    return FR_OK;
+}
+
+FRESULT SDImage::mirror(const char *path, BlockCache *source, struct smb2_context *smb2, struct smb2fh *fh,
+                        const uint8_t *header, uint32_t headerSize, uint64_t imageSize)
+{
+    close();
+    FRESULT fr = mount();
+    if (fr != FR_OK)
+        return fr;
+
+    // Files anywhere else are the user's, so are never replaced
+    size_t dirLen = strlen(SDIMAGE_MIRROR_DIR);
+    if (strncasecmp(path, SDIMAGE_MIRROR_DIR "/", dirLen + 1) || !path[dirLen + 1] || strlen(path) >= SDIMAGE_PATH_MAX)
+        return FR_INVALID_NAME;
+    f_mkdir(SDIMAGE_MIRROR_DIR);
+    fr = f_open(&fil, path, FA_READ | FA_WRITE | FA_CREATE_NEW);
+    if (fr == FR_EXIST && f_unlink(path) == FR_OK)
+        fr = f_open(&fil, path, FA_READ | FA_WRITE | FA_CREATE_NEW);
+    if (fr != FR_OK)
+        return fr;
+
+    // Make the file full size up front, contiguous if the card has room, so
+    // the link map stays small and copying never has to grow the file
+#if FF_USE_EXPAND
+    fr = f_expand(&fil, imageSize, 1);
+    if (fr != FR_OK)
+#endif
+        fr = f_lseek(&fil, imageSize);
+    UINT written;
+    if (fr == FR_OK && headerSize)
+    {
+        fr = f_lseek(&fil, 0);
+        if (fr == FR_OK)
+            fr = f_write(&fil, header, headerSize, &written);
+    }
+    if (fr == FR_OK && f_size(&fil) != imageSize)
+        fr = FR_DENIED;
+    if (fr == FR_OK && !(copy = (Copy *)malloc(sizeof(Copy))))
+        fr = FR_NOT_ENOUGH_CORE;
+    if (fr != FR_OK)
+    {
+        f_close(&fil);
+        f_unlink(path);
+        return fr;
+    }
+
+    copy->image = this;
+    copy->count = 0;
+    copy->busy = false;
+    strcpy(this->path, path);
+    isOpen = true;
+    writable = true;
+    fastSeek();
+    setHeaderSize(headerSize);
+    ready = 0;
+    this->source = source;
+    this->smb2 = smb2;
+    this->fh = fh;
+    return FR_OK;
+}
+
+void SDImage::close()
+{
+    if (!isOpen)
+        return;
+    endCopy(true);
+    f_close(&fil);
+    isOpen = false;
+    source = nullptr;
+    blocks = ready = 0;
+    path[0] = '\0';
+}
+
+/**
+ * A mirror's read came back.  One from a copy that was given up on is dropped
+ */
+void SDImage::copyDone(struct smb2_context *smb2, int status, void *command_data, void *private_data)
+{
+    Copy *copy = (Copy *)private_data;
+    if (copy->image->copy != copy)
+        return;
+    copy->status = status;
+    copy->busy = false;
+}
+
+/**
+ * Stop copying the mirror, which keeps the blocks it has.  A read in flight
+ * lands in copy->data, so it is waited for if wait, and if it does not come
+ * the RAM is left to it
+ */
+void SDImage::endCopy(bool wait)
+{
+    if (!copy)
+        return;
+    absolute_time_t timeout = make_timeout_time_ms(SDIMAGE_WAIT_MS);
+    while (wait && copy->busy && !time_reached(timeout) && BlockCache::serviceSMB(smb2) >= 0)
+        ;
+    if (!copy->busy)
+        free(copy);
+    copy = nullptr;
+    source = nullptr;
+    smb2 = nullptr;
+    fh = nullptr;
+}
+
+size_t SDImage::readAt(uint64_t offset, uint8_t *dest, size_t len)
+{
+    UINT read = 0;
+    if (!isOpen || f_lseek(&fil, offset) != FR_OK || f_read(&fil, dest, len, &read) != FR_OK)
+        return 0;
+    return read;
+}
+
+void SDImage::setHeaderSize(uint32_t headerSize)
+{
+    this->headerSize = headerSize;
+    FSIZE_t fileSize = f_size(&fil);
+    blocks = fileSize > headerSize ? (uint32_t)((fileSize - headerSize + BLOCK_SIZE - 1) / BLOCK_SIZE) : 0;
+    if (!source)
+        ready = blocks;
+}
+
+bool SDImage::seek(uint32_t block)
+{
+    return f_lseek(&fil, (FSIZE_t)block * BLOCK_SIZE + headerSize) == FR_OK;
+}
+
+bool SDImage::read(uint32_t block, uint8_t *dest)
+{
+    UINT read;
+    if (!holds(block) || !seek(block) || f_read(&fil, dest, BLOCK_SIZE, &read) != FR_OK)
+        return false;
+    // The last block of an image that is not a whole number of blocks
+    if (read < BLOCK_SIZE)
+        memset(&dest[read], 0, BLOCK_SIZE - read);
+    return true;
+}
+
+bool SDImage::write(uint32_t block, const uint8_t *src)
+{
+    UINT written;
+    if (!canWrite() || block >= blocks || !seek(block))
+        return false;
+    // The last block is cut short rather than grow the file
+    FSIZE_t room = f_size(&fil) - f_tell(&fil);
+    UINT len = room < BLOCK_SIZE ? (UINT)room : BLOCK_SIZE;
+    return f_write(&fil, src, len, &written) == FR_OK && written == len;
+}
+
+void SDImage::sync()
+{
+    if (isOpen && writable)
+        f_sync(&fil);
+}
+
+void SDImage::changed(uint32_t block)
+{
+    if (copy && copy->count && block >= copy->from && block < copy->from + copy->count)
+        copy->stale = true;
+}
+
+void SDImage::service()
+{
+    if (!mirroring())
+        return;
+
+    if (copy->busy)
+    {
+        if (BlockCache::serviceSMB(smb2) < 0)
+        {
+            // The server is gone, so serve what has been copied
+            endCopy(false);
+            return;
+        }
+        if (copy->busy)
+            return;
+    }
+
+    if (copy->count)
+    {
+        uint32_t count = copy->count;
+        copy->count = 0;
+        if (copy->status < 0)
+        {
+            endCopy(false);
+            return;
+        }
+        // A stale read is simply asked for again
+        if (!copy->stale)
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                uint8_t *block = &copy->data[i * BLOCK_SIZE];
+                // The last block of an image that is not a whole number of blocks
+                int have = copy->status - (int)(i * BLOCK_SIZE);
+                if (have < BLOCK_SIZE)
+                    memset(&block[have > 0 ? have : 0], 0, BLOCK_SIZE - (have > 0 ? have : 0));
+                // The cache has the block as the Apple II last wrote it
+                source->peek(ready + i, block);
+            }
+            UINT written;
+            FSIZE_t room = f_size(&fil) - ((FSIZE_t)ready * BLOCK_SIZE + headerSize);
+            UINT len = room < count * BLOCK_SIZE ? (UINT)room : count * BLOCK_SIZE;
+            if (!seek(ready) || f_write(&fil, copy->data, len, &written) != FR_OK || written != len)
+            {
+                // The card is failing, so keep serving from SMB
+                close();
+                return;
+            }
+            ready += count;
+        }
+    }
+
+    if (ready < blocks)
+    {
+        copy->from = ready;
+        copy->count = blocks - ready < SDIMAGE_MIRROR_STEP ? blocks - ready : SDIMAGE_MIRROR_STEP;
+        copy->stale = false;
+        copy->busy = true;
+        if (smb2_pread_async(smb2, fh, copy->data, copy->count * BLOCK_SIZE, (uint64_t)ready * BLOCK_SIZE + headerSize, copyDone, copy) < 0)
+        {
+            copy->busy = false;
+            endCopy(false);
+        }
+        return;
+    }
+    sync();
+    endCopy(false);
+}
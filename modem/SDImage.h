@@ -0,0 +1,136 @@
+/*
+  SDImage.h - disk image on the SD card, served block by block
+  Stefan Wessels, 2023
+*/
+#ifndef _SDIMAGE_H
+#define _SDIMAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <strings.h>
+#include "ff.h"
+#include "BlockCache.h"
+
+#define SDIMAGE_CLMT_SIZE   64      // Cluster link map entries, enough for an image in 31 fragments
+#define SDIMAGE_MIRROR_STEP 8       // Blocks a mirror reads from SMB at a time, 4K of heap while it copies
+#define SDIMAGE_MIRROR_DIR  "0:/mirror" // Where mirrors are made, and the only place they replace a file
+#define SDIMAGE_PATH_MAX    96
+
+/*
+ * An image file on the SD card.  Once open, a FatFs fast-seek cluster link
+ * map is built so seeking to a block never walks the FAT, and a block costs
+ * only the SPI transfer.
+ *
+ * An image can also be a mirror of one that is served over SMB.  mirror()
+ * creates the copy, in SDIMAGE_MIRROR_DIR, and service() fills it in the
+ * background, in order.  The mirror reads the image with requests of its
+ * own, so the blocks the Apple II uses are not pushed out of the BlockCache.
+ * A block the cache holds is taken from there instead, as it may be newer
+ * than the image, and changed() has a block the Apple II wrote while it was
+ * on its way read again.  holds() tells which blocks the copy already has.
+ */
+class SDImage
+{
+private:
+    static FATFS fs;
+    static bool fsMounted;
+
+    FIL fil;
+    DWORD clmt[SDIMAGE_CLMT_SIZE];
+    bool isOpen = false;
+    bool writable = false;
+    uint32_t headerSize = 0;
+    uint32_t blocks = 0;
+    uint32_t ready = 0;             // Blocks [0, ready) are on the card
+    char path[SDIMAGE_PATH_MAX];
+    BlockCache *source = nullptr;   // Where a mirror comes from until it is complete
+    struct smb2_context *smb2 = nullptr;
+    struct smb2fh *fh = nullptr;
+
+    // A mirror's read of the SMB image.  One the mirror gives up on is left
+    // to the request, which then lands in RAM nothing else uses
+    struct Copy
+    {
+        SDImage *image;
+        uint32_t from;      // First block asked for
+        uint32_t count;     // Blocks asked for, 0 when there is no read
+        int status;         // Bytes read, or < 0, once the read is done
+        bool busy;          // The read is in flight
+        bool stale;         // A block in it was written after it was asked for
+        uint8_t data[SDIMAGE_MIRROR_STEP * BLOCK_SIZE];
+    };
+    Copy *copy = nullptr;
+
+    static void copyDone(struct smb2_context *smb2, int status, void *command_data, void *private_data);
+    void endCopy(bool wait);
+    void fastSeek();
+    bool seek(uint32_t block);
+
+public:
+    SDImage() { path[0] = '\0'; }
+
+    /**
+     * Mount the card's volume once, for the images and any other file on it
+     */
+    static FRESULT mount();
+
+    /**
+     * Open an image, path being relative to the root of the card.  If it can
+     * not be written it is opened read only, which writable then reports
+     */
+    FRESULT open(const char *path);
+
+    /**
+     * Create path, in SDIMAGE_MIRROR_DIR, as an empty copy of the image fh
+     * of imageSize bytes, and start filling it in.  A file of that name left
+     * in SDIMAGE_MIRROR_DIR by an earlier mirror is replaced, so check that
+     * no other image uses path first.  source is the image's cache.
+     * headerSize is the size of the image's 2MG header, if any, which is
+     * copied from header
+     */
+    FRESULT mirror(const char *path, BlockCache *source, struct smb2_context *smb2, struct smb2fh *fh,
+                   const uint8_t *header, uint32_t headerSize, uint64_t imageSize);
+
+    /**
+     * Flush and close the file
+     */
+    void close();
+
+    /**
+     * Read bytes from anywhere in the file, for looking at a header
+     */
+    size_t readAt(uint64_t offset, uint8_t *dest, size_t len);
+
+    /**
+     * Blocks start headerSize bytes into the file
+     */
+    void setHeaderSize(uint32_t headerSize);
+
+    bool opened() { return isOpen; }
+    bool uses(const char *path) { return isOpen && !strcasecmp(this->path, path); }
+    bool canWrite() { return isOpen && writable; }
+    bool holds(uint32_t block) { return isOpen && block < ready; }
+    bool mirroring() { return isOpen && source && ready < blocks; }
+    uint64_t size() { return isOpen ? f_size(&fil) : 0; }
+
+    bool read(uint32_t block, uint8_t *dest);
+    bool write(uint32_t block, const uint8_t *src);
+
+    /**
+     * Commit writes to the card
+     */
+    void sync();
+
+    /**
+     * The Apple II wrote block to the SMB image, so a mirror that is reading
+     * it reads it again
+     */
+    void changed(uint32_t block);
+
+    /**
+     * Copy some more of a mirror without blocking
+     */
+    void service();
+};
+
+#endif // _SDIMAGE_H
@@ -0,0 +1,128 @@
+/*
+  SSHKey.cpp - the modem's own SSH user key
+  Stefan Wessels, 2023
+*/
+#include "SSHKey.h"
+#include <string.h>
+#include <wolfssl/wolfcrypt/ecc.h>
+#include <wolfssl/wolfcrypt/random.h>
+#include <wolfssl/wolfcrypt/asn_public.h>
+#include <wolfssl/wolfcrypt/coding.h>
+
+bool SSHKey::isLoaded = false;
+uint8_t SSHKey::blob[SSHKEY_BLOB_SIZE];
+uint32_t SSHKey::blobSize = 0;
+uint8_t SSHKey::der[SSHKEY_DER_SIZE];
+uint32_t SSHKey::derSize = 0;
+
+// Append an SSH string, a 32 bit big endian length and the bytes
+static uint8_t *putString(uint8_t *p, const uint8_t *data, uint32_t size)
+{
+    *p++ = size >> 24;
+    *p++ = size >> 16;
+    *p++ = size >> 8;
+    *p++ = size;
+    memcpy(p, data, size);
+    return p + size;
+}
+
+static int hexDigit(char c)
+{
+    if(c >= '0' && c <= '9')
+        return c - '0';
+    if(c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if(c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+bool SSHKey::generate(String &privateHex)
+{
+    static const char hex[] = "0123456789abcdef";
+    uint8_t priv[SSHKEY_PRIVATE_SIZE];
+    word32 privSize = sizeof(priv);
+    bool made = false;
+
+    // The key and RNG are big with fast math, so they go on the heap
+    WC_RNG *rng = wc_rng_new(NULL, 0, NULL);
+    if(!rng)
+        return false;
+    ecc_key *key = wc_ecc_key_new(NULL);
+    if(key)
+    {
+        made = !wc_ecc_make_key_ex(rng, SSHKEY_PRIVATE_SIZE, key, ECC_SECP256R1) &&
+               !wc_ecc_export_private_only(key, priv, &privSize) &&
+               privSize == SSHKEY_PRIVATE_SIZE;
+        wc_ecc_key_free(key);
+    }
+    wc_rng_free(rng);
+
+    if(made)
+    {
+        privateHex = "";
+        for(int i=0; i<SSHKEY_PRIVATE_SIZE; i++)
+        {
+            privateHex += hex[priv[i] >> 4];
+            privateHex += hex[priv[i] & 0x0f];
+        }
+    }
+    memset(priv, 0, sizeof(priv));
+    return made;
+}
+
+bool SSHKey::load(const String &privateHex)
+{
+    uint8_t priv[SSHKEY_PRIVATE_SIZE];
+    uint8_t point[SSHKEY_POINT_SIZE];
+    word32 pointSize = sizeof(point);
+    int size = -1;
+
+    isLoaded = false;
+    if(privateHex.length() != 2 * SSHKEY_PRIVATE_SIZE)
+        return false;
+    for(int i=0; i<SSHKEY_PRIVATE_SIZE; i++)
+    {
+        int hi = hexDigit(privateHex[2*i]);
+        int lo = hexDigit(privateHex[2*i+1]);
+        if(hi < 0 || lo < 0)
+            return false;
+        priv[i] = (hi << 4) | lo;
+    }
+
+    // This runs from loadSettings() before the scheduler, on main's small
+    // stack, so the key goes on the heap
+    ecc_key *key = wc_ecc_key_new(NULL);
+    if(key)
+    {
+        if(!wc_ecc_import_private_key_ex(priv, sizeof(priv), NULL, 0, key, ECC_SECP256R1) &&
+           !wc_ecc_make_pub(key, NULL) &&
+           !wc_ecc_export_x963(key, point, &pointSize) &&
+           pointSize == SSHKEY_POINT_SIZE)
+            size = wc_EccKeyToDer(key, der, sizeof(der));
+        wc_ecc_key_free(key);
+    }
+    memset(priv, 0, sizeof(priv));
+    if(size <= 0)
+        return false;
+    derSize = size;
+
+    uint8_t *p = putString(blob, (const uint8_t *)SSHKEY_TYPE, sizeof(SSHKEY_TYPE) - 1);
+    p = putString(p, (const uint8_t *)SSHKEY_CURVE, sizeof(SSHKEY_CURVE) - 1);
+    p = putString(p, point, pointSize);
+    blobSize = p - blob;
+
+    isLoaded = true;
+    return true;
+}
+
+String SSHKey::publicKeyLine(const char *comment)
+{
+    uint8_t text[(SSHKEY_BLOB_SIZE + 2) / 3 * 4 + 1];
+    word32 textSize = sizeof(text) - 1;
+
+    if(!isLoaded || Base64_Encode_NoNl(blob, blobSize, text, &textSize))
+        return "";
+    text[textSize] = '\0';
+    return String(SSHKEY_TYPE) + " " + (const char *)text + " " + comment;
+}
@@ -0,0 +1,58 @@
+/*
+  SSHKey.h - the modem's own SSH user key
+  Stefan Wessels, 2023
+*/
+#ifndef _SSHKEY_H
+#define _SSHKEY_H
+
+#include <stdint.h>
+#include "WString.h"
+
+#define SSHKEY_TYPE         "ecdsa-sha2-nistp256"
+#define SSHKEY_CURVE        "nistp256"
+#define SSHKEY_PRIVATE_SIZE 32      // Bytes in a P-256 private key, kept in settings as 64 hex digits
+#define SSHKEY_POINT_SIZE   65      // Uncompressed P-256 public point
+#define SSHKEY_BLOB_SIZE    (4 + sizeof(SSHKEY_TYPE) - 1 + 4 + sizeof(SSHKEY_CURVE) - 1 + 4 + SSHKEY_POINT_SIZE)
+#define SSHKEY_DER_SIZE     128     // Room for the private key in SEC1 DER form
+
+/*
+ * One ECDSA P-256 key pair used to log in to SSH servers.  Only the private
+ * scalar is stored, as hex, with the rest of the settings.  load() derives
+ * from it everything wolfSSH needs to sign with the key - the public key in
+ * SSH wire form and the private key as DER - so that work is done once, and
+ * not on every ATDSSH.
+ */
+class SSHKey
+{
+private:
+    static bool isLoaded;
+    static uint8_t blob[SSHKEY_BLOB_SIZE];
+    static uint32_t blobSize;
+    static uint8_t der[SSHKEY_DER_SIZE];
+    static uint32_t derSize;
+
+public:
+    /*
+     * Make a new key pair and return its private key as hex, for the settings.
+     * The key is not loaded
+     */
+    static bool generate(String &privateHex);
+
+    /*
+     * Make privateHex the key offered to servers.  An empty string forgets the
+     * key, and so does one that is not a valid key
+     */
+    static bool load(const String &privateHex);
+
+    static bool loaded() { return isLoaded; }
+    static const char *type() { return SSHKEY_TYPE; }
+    static const uint8_t *publicBlob(uint32_t *size) { *size = blobSize; return blob; }
+    static const uint8_t *privateDer(uint32_t *size) { *size = derSize; return der; }
+
+    /*
+     * The public key as a line for a server's authorized_keys file
+     */
+    static String publicKeyLine(const char *comment);
+};
+
+#endif // _SSHKEY_H
@@ -6,58 +6,13 @@
 
 #include "Serial.h"
 #include <pico/stdlib.h>
+#include <hardware/dma.h>
+#include <hardware/irq.h>
+#include <hardware/structs/scb.h>
+#include <hardware/structs/systick.h>
+#include <hardware/clocks.h>
 #include <stdio.h>
-
-// RP2040 has 2 uarts, 0 and 1.  These are the rx/tx buffers for the uarts
-queue_t uart0Rx, uart0Tx, uart1Rx, uart1Tx;
-
-/*
- * All Read and writes happen in a uart IRQ, and is handeled here for uart0
- */
-void uart0_irq()
-{
-    static uint8_t data;
-    if(uart_is_readable(uart0) && !queue_is_full(&uart0Rx))
-    {
-        data = uart_getc(uart0);
-        queue_try_add(&uart0Rx, &data);
-    }
-
-    if(!queue_is_empty(&uart0Tx) && uart_is_writable(uart0))
-    {
-        queue_try_remove(&uart0Tx, &data);
-        uart_putc_raw(uart0, data);
-    }
-
-    if(queue_is_empty(&uart0Tx))
-    {
-        uart_set_irq_enables(uart0, true, false);
-    }
-}
-
-/*
- * All Read and writes happen in a uart IRQ, and is handeled here for uart1
- */
-void uart1_irq()
-{
-    static uint8_t data;
-    while(uart_is_readable(uart1) && !queue_is_full(&uart1Rx))
-    {
-        data = uart_getc(uart1);
-        queue_try_add(&uart1Rx, &data);
-    }
-
-    while(!queue_is_empty(&uart1Tx) && uart_is_writable(uart1))
-    {
-        queue_try_remove(&uart1Tx, &data);
-        uart_putc_raw(uart1, data);
-    }
-
-    if(queue_is_empty(&uart1Tx))
-    {
-        uart_set_irq_enables(uart1, true, false);
-    }
-}
+#include <string.h>
 
 /*
  * One time init of a uart (0|1).
@@ -70,31 +25,40 @@ bool Serial_::setup(uart_inst_t *instance, uint baudrate, uint data_bits, uint s
 
     uartInstance = instance;
 
-    if (uartInstance == uart0)
-    {
-        rx = &uart0Rx;
-        tx = &uart0Tx;
-        uartIRQ = UART0_IRQ;
-    }
-    else
+    if (uartInstance == uart1)
     {
         tx_pin = 4;
         rx_pin = 5;
-        rx = &uart1Rx;
-        tx = &uart1Tx;
-        uartIRQ = UART1_IRQ;
     }
-    queue_init(rx, 1, 256);
-    queue_init(tx, 1, 256);
+    rxPin = rx_pin;
 
+    // uart_init also turns on the UART's DMA requests
     uart_init(uartInstance, baudrate);
     uart_set_hw_flow(uartInstance, true, true);
     uart_set_format(uartInstance, data_bits, stop_bits, parity);
     uart_set_fifo_enabled(uartInstance, true);
     uart_set_translate_crlf(uartInstance, false);
-    irq_set_exclusive_handler(uartIRQ, (uartInstance == uart0 ? uart0_irq : uart1_irq));
-    irq_set_enabled(uartIRQ, true);
-    uart_set_irq_enables(uartInstance, true, false);
+
+    // From the data register into rxRing, paced by the UART RX request
+    rxDMA = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(rxDMA);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, uart_get_dreq(uartInstance, false));
+    dma_channel_configure(rxDMA, &c, rxRing, &uart_get_hw(uartInstance)->dr, 0, false);
+
+    // From the caller's buffer to the data register, paced by the UART TX request
+    txDMA = dma_claim_unused_channel(true);
+    c = dma_channel_get_default_config(txDMA);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, uart_get_dreq(uartInstance, true));
+    dma_channel_configure(txDMA, &c, &uart_get_hw(uartInstance)->dr, NULL, 0, false);
+
+    rxStart = rxCount = rxOut = 0;
+    rxArm();
 
     gpio_set_function(tx_pin, GPIO_FUNC_UART); // TX pin
     gpio_set_function(rx_pin, GPIO_FUNC_UART); // RX Pin
@@ -111,11 +75,45 @@ int Serial_::baud(uint baudrate)
 }
 
 /*
- * Return TRUE if the rx queue is NOT empty, so a read will not block
+ * Total bytes received, counting the ones the DMA transfer in progress has
+ * written so far
+ */
+uint32_t Serial_::rxIn()
+{
+    uint32_t left = dma_channel_hw_addr(rxDMA)->transfer_count;
+    // The bytes the count says are written have to be read after it
+    __compiler_memory_barrier();
+    return rxStart + rxCount - left;
+}
+
+/*
+ * Once a transfer is done, start the next one on the free span of the ring
+ * that follows it.  A full ring starts nothing, till some of it is read
+ */
+void Serial_::rxArm()
+{
+    if (dma_channel_is_busy(rxDMA))
+        return;
+
+    uint32_t in = rxStart + rxCount;
+    uint32_t pos = in % SERIAL_RX_SIZE;
+    uint32_t len = SERIAL_RX_SIZE - (in - rxOut);
+    if (len > SERIAL_RX_SIZE - pos)
+        len = SERIAL_RX_SIZE - pos;
+
+    rxStart = in;
+    rxCount = len;
+    if (len)
+        dma_channel_transfer_to_buffer_now(rxDMA, &rxRing[pos], len);
+}
+
+/*
+ * Return how many bytes can be read without blocking
  */
 int Serial_::available()
 {
-    return !queue_is_empty(rx);
+    rxArm();
+    return (int)(rxIn() - rxOut);
 }
 
 /*
@@ -123,45 +121,137 @@ int Serial_::available()
  */
 int Serial_::peek()
 {
-    uint8_t data;
-    queue_peek_blocking(rx, &data);
-    return data;
+    while (!available())
+        tight_loop_contents();
+    return rxRing[rxOut % SERIAL_RX_SIZE];
 }
 
 /*
- * Will block/send till entire buffer is sent
- * Sets interrupt to start sending
+ * Copy what has been received, up to size bytes, out of the ring
  */
-size_t Serial_::Write(const uint8_t *buffer, size_t size)
+size_t Serial_::Read(uint8_t *buffer, size_t size)
 {
+    uint32_t in = rxIn();
     size_t count = 0;
-    bool irq_set = false;
 
-    // Loop till all bytes sent
-    while (count < size)
+    while (count < size && rxOut != in)
     {
-        queue_add_blocking(tx, &buffer[count]);
-        count++;
-        if(!irq_set)
-        {
-            // Sstart uart send pump
-            uart_set_irq_enables(uartInstance, true, true);
-            irq_set_pending(uartIRQ);
-            irq_set = true;
-        }
+        uint32_t pos = rxOut % SERIAL_RX_SIZE;
+        size_t len = SERIAL_RX_SIZE - pos;
+        if (len > in - rxOut)
+            len = in - rxOut;
+        if (len > size - count)
+            len = size - count;
+        memcpy(&buffer[count], &rxRing[pos], len);
+        count += len;
+        rxOut += len;
     }
+    rxArm();
     return count;
 }
 
 /*
- * Read a single character from rx
- * Will block if rxBuffer is empty
+ * Read a single character
+ * Will block if nothing has been received
  */
 int Serial_::Read()
 {
     uint8_t data;
-    queue_remove_blocking(rx, &data);
+    while (!Read(&data, 1))
+        tight_loop_contents();
     return data;
 }
 
+/*
+ * Start sending buffer, waiting only for a previous send to finish
+ */
+void Serial_::writeStart(const uint8_t *buffer, size_t size)
+{
+    dma_channel_wait_for_finish_blocking(txDMA);
+    dma_channel_transfer_from_buffer_now(txDMA, buffer, size);
+}
+
+bool Serial_::writing()
+{
+    return dma_channel_is_busy(txDMA);
+}
+
+/*
+ * Will block till the entire buffer is in the UART
+ */
+size_t Serial_::Write(const uint8_t *buffer, size_t size)
+{
+    writeStart(buffer, size);
+    dma_channel_wait_for_finish_blocking(txDMA);
+    return size;
+}
+
+/*
+ * The interrupts are left disabled in the NVIC, so they only ever pend, and
+ * SEVONPEND turns a new pending interrupt into a WFE wake up.  DMA_IRQ_0 is
+ * left to the SD card's SPI
+ */
+void Serial_::wakeOnActivity()
+{
+    hw_set_bits(&scb_hw->scr, M0PLUS_SCR_SEVONPEND_BITS);
+    irq_set_enabled(IO_IRQ_BANK0, false);
+    irq_set_enabled(DMA_IRQ_1, false);
+    gpio_set_irq_enabled(rxPin, GPIO_IRQ_EDGE_FALL, true);
+    dma_channel_set_irq1_enabled(txDMA, true);
+}
+
+void Serial_::clearActivity()
+{
+    gpio_acknowledge_irq(rxPin, GPIO_IRQ_EDGE_FALL);
+    dma_channel_acknowledge_irq1(txDMA);
+    irq_clear(IO_IRQ_BANK0);
+    irq_clear(DMA_IRQ_1);
+}
+
+/*
+ * SysTick counts clk_sys cycles, so even at 921600 (136 cycles a bit) the
+ * pulse is timed to a few percent.  The idle line is remembered in startBit
+ * between calls, so timeoutUs can be a small slice of idleUs.  Returns 0 if
+ * no start bit came within timeoutUs, else the ns the line was low, which is
+ * more than 1ms for a break
+ */
+uint32_t Serial_::measureBit(uint32_t idleUs, uint32_t timeoutUs)
+{
+    uint32_t start = time_us_32();
+
+    // A byte received since the last look means the line was not idle
+    uint32_t in = rxIn();
+    if (in != rxSeen)
+        startBit.reset();
+    rxSeen = in;
+
+    while (!startBit.sample(gpio_get(rxPin), time_us_32(), idleUs))
+    {
+        if (time_us_32() - start > timeoutUs)
+            return 0;
+    }
+
+    uint32_t clock = clock_get_hz(clk_sys);
+    uint32_t maxTicks = clock / 1000;   // A bit longer than 1ms is a break, not a rate
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = M0PLUS_SYST_CSR_CLKSOURCE_BITS | M0PLUS_SYST_CSR_ENABLE_BITS;
+    uint32_t t0 = systick_hw->cvr, ticks;
+    do
+    {
+        ticks = (t0 - systick_hw->cvr) & 0x00FFFFFF;
+    } while (!gpio_get(rxPin) && ticks < maxTicks);
+    systick_hw->csr = 0;
+
+    return (uint32_t)((uint64_t)ticks * 1000000000 / clock);
+}
+
+void Serial_::discard()
+{
+    rxArm();
+    rxOut = rxIn();
+    rxArm();
+    rxSeen = rxIn();
+}
+
 #endif
@@ -6,36 +6,75 @@
 #define serial_h
 
 #include "Stream.h"
-#include <pico/util/queue.h>
+#include "StartBit.h"
 #include <hardware/uart.h>
 
 #include <stdio.h>
 
+#define SERIAL_RX_SIZE  1024    // Receive ring, filled by DMA
+
 /*
- * One of these classes to manage a UART
+ * One of these classes to manage a UART.  Both directions are moved by DMA,
+ * so the CPU only touches the data in bulk.
+ *
+ * Received bytes go straight from the UART into rxRing.  The DMA is only
+ * ever given the free, contiguous part of the ring, so when the ring is full
+ * it stops, the UART FIFO fills up and hardware flow control (RTS) holds off
+ * the sender instead of bytes being overwritten.  The DMA is re-armed as the
+ * ring is read.
+ *
+ * Sending hands the DMA the caller's buffer, which must stay untouched until
+ * writing() is false.
+ *
+ * After wakeOnActivity(), a start bit on RX or the end of a send leaves an
+ * interrupt pending on the calling core.  No handler runs, but with SEVONPEND
+ * that wakes the core from WFE.  clearActivity() rearms it.
+ *
+ * measureBit() times the first low pulse on RX after the line has been idle,
+ * which for "AT" or "at" is the start bit of the A, so one bit time.  How
+ * long the line has been idle carries over from one call to the next.
  */
 class Serial_ : public Stream
 {
 private:
-    int uartIRQ = 0;
     uart_inst_t *uartInstance = NULL;
-    queue_t   *rx = nullptr, *tx = nullptr;
+    uint rxPin = 0;
+    int rxDMA = -1, txDMA = -1;
+    uint8_t rxRing[SERIAL_RX_SIZE];
+    uint32_t rxStart = 0;       // Bytes received before the DMA transfer in progress
+    uint32_t rxCount = 0;       // Length of that transfer
+    uint32_t rxOut = 0;         // Bytes taken out of the ring
+    uint32_t rxSeen = 0;        // rxIn() at the last measureBit
+    StartBit startBit;
+
+    uint32_t rxIn();
+    void rxArm();
 
 public:
     Serial_() { ; }
 
-    bool setup(uart_inst_t *instance,                 // Call once to make RX and TX buffers and set basic parameters
+    bool setup(uart_inst_t *instance,                 // Call once to claim the DMA channels and set basic parameters
                uint baudrate,
                uint data_bits,
                uint stop_bits,
                uart_parity_t parity);
 
     int baud(uint baudrate);
-    int available();                                  // 0 if a Read will block, 1 if char available
-    int peek();                                       // -1 if buffer head == tail, else next char to be Read
-    size_t Write(const uint8_t *buffer, size_t size); // copy as many bytes from buffer to txbuffer as will fit
-    size_t Write(uint8_t c) {return Write(&c,1);}     // single character into txbuffer, block if buffer full
-    int Read();                                       // get single char from rxbuf. block if buffer empty
+    int available();                                  // Bytes that can be Read without blocking
+    int peek();                                       // Next char to be Read, blocks if there is none
+    size_t Read(uint8_t *buffer, size_t size);        // Copy up to size received bytes, never blocks
+    int Read();                                       // get single char. block if none received
+
+    void writeStart(const uint8_t *buffer, size_t size); // Start sending buffer and return at once
+    bool writing();                                   // True while the last writeStart is still being sent
+    size_t Write(const uint8_t *buffer, size_t size); // Send buffer, blocking till it is all handed to the UART
+    size_t Write(uint8_t c) {return Write(&c,1);}
+
+    void wakeOnActivity();                            // Call on the core that will WFE
+    void clearActivity();                             // Call before looking for work, then WFE if there was none
+
+    uint32_t measureBit(uint32_t idleUs, uint32_t timeoutUs); // ns of a start bit after idleUs of idle line, 0 if none in timeoutUs
+    void discard();                                   // Drop everything received so far
 };
 
-#endif // serial_h
\ No newline at end of file
+#endif // serial_h
@@ -0,0 +1,43 @@
+/*
+  StartBit.h - find the start bit of an "AT" on a sampled RX line
+  Stefan Wessels, 2023
+*/
+#ifndef startbit_h
+#define startbit_h
+
+#include <stdint.h>
+
+/*
+ * Watches RX samples for a falling edge that comes after the line has been
+ * high for at least idleUs - the start bit of the A in "AT", and not a bit in
+ * the middle of a character.  When the line went high is kept from one call
+ * to the next, so the search can be spread over many short slices, each
+ * much shorter than the idle time.  reset() forgets the idle line, for when
+ * something may have come in while no one was looking
+ */
+class StartBit
+{
+private:
+    bool high = false;
+    uint32_t highSince = 0;
+
+public:
+    void reset() { high = false; }
+
+    // true if this sample is the falling edge of a start bit
+    bool sample(bool level, uint32_t nowUs, uint32_t idleUs)
+    {
+        if (level)
+        {
+            if (!high)
+                highSince = nowUs;
+            high = true;
+            return false;
+        }
+        bool edge = high && nowUs - highSince >= idleUs;
+        high = false;
+        return edge;
+    }
+};
+
+#endif // startbit_h
@@ -0,0 +1,428 @@
+/*
+  Telnet.cpp - incremental telnet protocol codec
+  Stefan Wessels, 2023
+*/
+#include "Telnet.h"
+#include <string.h>
+
+void Telnet::begin(Print *peer)
+{
+    this->peer = peer;
+    reset();
+}
+
+void Telnet::reset()
+{
+    state = S_DATA;
+    command = 0;
+    sbLen = 0;
+    memset(options, 0, sizeof(options));
+}
+
+void Telnet::setWindowSize(uint16_t columns, uint16_t rows)
+{
+    width = columns;
+    height = rows;
+    if (usEnabled(TELOPT_NAWS))
+        sendNAWS();
+}
+
+/**
+ * Options this side is willing to perform when asked with DO
+ */
+bool Telnet::acceptUs(uint8_t option)
+{
+    return option == TELOPT_BINARY || option == TELOPT_SGA || option == TELOPT_TTYPE || option == TELOPT_NAWS;
+}
+
+/**
+ * Options the remote side is allowed to perform when it offers WILL
+ */
+bool Telnet::acceptHim(uint8_t option)
+{
+    return option == TELOPT_BINARY || option == TELOPT_ECHO || option == TELOPT_SGA;
+}
+
+void Telnet::send(uint8_t cmd, uint8_t option)
+{
+    uint8_t reply[] = {T_IAC, cmd, option};
+    if (peer)
+        peer->Write(reply, sizeof(reply));
+}
+
+/**
+ * Report the window size - IAC SB NAWS w16 h16 IAC SE, with any 0xff in the sizes doubled
+ */
+void Telnet::sendNAWS()
+{
+    uint8_t msg[3 + 8 + 2];
+    size_t len = 0;
+    uint8_t sizes[] = {(uint8_t)(width >> 8), (uint8_t)width, (uint8_t)(height >> 8), (uint8_t)height};
+
+    msg[len++] = T_IAC;
+    msg[len++] = T_SB;
+    msg[len++] = TELOPT_NAWS;
+    for (size_t i = 0; i < sizeof(sizes); i++)
+    {
+        msg[len++] = sizes[i];
+        if (sizes[i] == T_IAC)
+            msg[len++] = T_IAC;
+    }
+    msg[len++] = T_IAC;
+    msg[len++] = T_SE;
+    if (peer)
+        peer->Write(msg, len);
+}
+
+/**
+ * RFC 1143 - the remote side sent WILL
+ */
+void Telnet::receivedWill(uint8_t option)
+{
+    if (option >= TELNET_OPTIONS)
+    {
+        send(T_DONT, option);
+        return;
+    }
+    Option &o = options[option];
+    switch (o.him)
+    {
+    case Q_NO:
+        if (acceptHim(option))
+        {
+            o.him = Q_YES;
+            send(T_DO, option);
+        }
+        else
+        {
+            send(T_DONT, option);
+        }
+        break;
+    case Q_YES:
+        break;
+    case Q_WANTNO:
+        // DONT answered by WILL is a protocol error, but settles the state
+        o.him = o.himq ? Q_YES : Q_NO;
+        o.himq = 0;
+        break;
+    case Q_WANTYES:
+        if (o.himq)
+        {
+            o.him = Q_WANTNO;
+            o.himq = 0;
+            send(T_DONT, option);
+        }
+        else
+        {
+            o.him = Q_YES;
+        }
+        break;
+    }
+}
+
+/**
+ * RFC 1143 - the remote side sent WONT
+ */
+void Telnet::receivedWont(uint8_t option)
+{
+    if (option >= TELNET_OPTIONS)
+        return;
+    Option &o = options[option];
+    switch (o.him)
+    {
+    case Q_NO:
+        break;
+    case Q_YES:
+        o.him = Q_NO;
+        send(T_DONT, option);
+        break;
+    case Q_WANTNO:
+        if (o.himq)
+        {
+            o.him = Q_WANTYES;
+            o.himq = 0;
+            send(T_DO, option);
+        }
+        else
+        {
+            o.him = Q_NO;
+        }
+        break;
+    case Q_WANTYES:
+        o.him = Q_NO;
+        o.himq = 0;
+        break;
+    }
+}
+
+/**
+ * RFC 1143 - the remote side sent DO
+ */
+void Telnet::receivedDo(uint8_t option)
+{
+    if (option >= TELNET_OPTIONS)
+    {
+        send(T_WONT, option);
+        return;
+    }
+    Option &o = options[option];
+    switch (o.us)
+    {
+    case Q_NO:
+        if (acceptUs(option))
+        {
+            o.us = Q_YES;
+            send(T_WILL, option);
+            if (option == TELOPT_NAWS)
+                sendNAWS();
+        }
+        else
+        {
+            send(T_WONT, option);
+        }
+        break;
+    case Q_YES:
+        break;
+    case Q_WANTNO:
+        o.us = o.usq ? Q_YES : Q_NO;
+        o.usq = 0;
+        break;
+    case Q_WANTYES:
+        if (o.usq)
+        {
+            o.us = Q_WANTNO;
+            o.usq = 0;
+            send(T_WONT, option);
+        }
+        else
+        {
+            o.us = Q_YES;
+            if (option == TELOPT_NAWS)
+                sendNAWS();
+        }
+        break;
+    }
+}
+
+/**
+ * RFC 1143 - the remote side sent DONT
+ */
+void Telnet::receivedDont(uint8_t option)
+{
+    if (option >= TELNET_OPTIONS)
+        return;
+    Option &o = options[option];
+    switch (o.us)
+    {
+    case Q_NO:
+        break;
+    case Q_YES:
+        o.us = Q_NO;
+        send(T_WONT, option);
+        break;
+    case Q_WANTNO:
+        if (o.usq)
+        {
+            o.us = Q_WANTYES;
+            o.usq = 0;
+            send(T_WILL, option);
+        }
+        else
+        {
+            o.us = Q_NO;
+        }
+        break;
+    case Q_WANTYES:
+        o.us = Q_NO;
+        o.usq = 0;
+        break;
+    }
+}
+
+void Telnet::requestUs(uint8_t option, bool enable)
+{
+    if (option >= TELNET_OPTIONS)
+        return;
+    Option &o = options[option];
+    switch (o.us)
+    {
+    case Q_NO:
+        if (enable)
+        {
+            o.us = Q_WANTYES;
+            send(T_WILL, option);
+        }
+        break;
+    case Q_YES:
+        if (!enable)
+        {
+            o.us = Q_WANTNO;
+            send(T_WONT, option);
+        }
+        break;
+    case Q_WANTNO:
+        o.usq = enable;
+        break;
+    case Q_WANTYES:
+        o.usq = !enable;
+        break;
+    }
+}
+
+void Telnet::requestHim(uint8_t option, bool enable)
+{
+    if (option >= TELNET_OPTIONS)
+        return;
+    Option &o = options[option];
+    switch (o.him)
+    {
+    case Q_NO:
+        if (enable)
+        {
+            o.him = Q_WANTYES;
+            send(T_DO, option);
+        }
+        break;
+    case Q_YES:
+        if (!enable)
+        {
+            o.him = Q_WANTNO;
+            send(T_DONT, option);
+        }
+        break;
+    case Q_WANTNO:
+        o.himq = enable;
+        break;
+    case Q_WANTYES:
+        o.himq = !enable;
+        break;
+    }
+}
+
+/**
+ * A complete IAC SB ... IAC SE arrived.  Only TTYPE SEND needs an answer
+ */
+void Telnet::subnegotiation()
+{
+    if (sbLen >= 2 && sb[0] == TELOPT_TTYPE && sb[1] == 1 && usEnabled(TELOPT_TTYPE))
+    {
+        uint8_t head[] = {T_IAC, T_SB, TELOPT_TTYPE, 0};
+        uint8_t tail[] = {T_IAC, T_SE};
+        if (peer)
+        {
+            peer->Write(head, sizeof(head));
+            peer->Write((const uint8_t *)terminalType, strlen(terminalType));
+            peer->Write(tail, sizeof(tail));
+        }
+    }
+}
+
+size_t Telnet::decode(const uint8_t *in, size_t len, uint8_t *out)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        uint8_t c = in[i];
+        switch (state)
+        {
+        case S_CR:
+            // Outside of binary mode a CR is sent as CR NUL - drop the NUL
+            state = S_DATA;
+            if (c == 0)
+                break;
+            // fall through
+        case S_DATA:
+            if (c == T_IAC)
+            {
+                state = S_IAC;
+            }
+            else
+            {
+                out[count++] = c;
+                if (c == '\r' && !himEnabled(TELOPT_BINARY))
+                    state = S_CR;
+            }
+            break;
+
+        case S_IAC:
+            if (c == T_IAC)
+            {
+                // 2 times 0xff is just an escaped real 0xff
+                out[count++] = T_IAC;
+                state = S_DATA;
+            }
+            else if (c == T_WILL || c == T_WONT || c == T_DO || c == T_DONT)
+            {
+                command = c;
+                state = S_OPTION;
+            }
+            else if (c == T_SB)
+            {
+                sbLen = 0;
+                state = S_SB;
+            }
+            else
+            {
+                // NOP, GA, AYT, etc. carry no option and are ignored
+                state = S_DATA;
+            }
+            break;
+
+        case S_OPTION:
+            switch (command)
+            {
+            case T_WILL: receivedWill(c); break;
+            case T_WONT: receivedWont(c); break;
+            case T_DO:   receivedDo(c);   break;
+            case T_DONT: receivedDont(c); break;
+            }
+            state = S_DATA;
+            break;
+
+        case S_SB:
+            if (c == T_IAC)
+                state = S_SB_IAC;
+            else if (sbLen < TELNET_SB_MAX)
+                sb[sbLen++] = c;
+            break;
+
+        case S_SB_IAC:
+            if (c == T_SE)
+            {
+                subnegotiation();
+                state = S_DATA;
+            }
+            else
+            {
+                // IAC IAC inside a subnegotiation is a data 0xff
+                if (c == T_IAC && sbLen < TELNET_SB_MAX)
+                    sb[sbLen++] = c;
+                state = S_SB;
+            }
+            break;
+        }
+    }
+    return count;
+}
+
+size_t Telnet::escape(const uint8_t *in, size_t len, uint8_t *out, size_t outSize, size_t *used)
+{
+    size_t i, count = 0;
+    for (i = 0; i < len; i++)
+    {
+        if (in[i] == T_IAC)
+        {
+            if (count + 2 > outSize)
+                break;
+            out[count++] = T_IAC;
+        }
+        else if (count + 1 > outSize)
+        {
+            break;
+        }
+        out[count++] = in[i];
+    }
+    if (used)
+        *used = i;
+    return count;
+}
@@ -0,0 +1,131 @@
+/*
+  Telnet.h - incremental telnet protocol codec
+  Stefan Wessels, 2023
+*/
+#ifndef _TELNET_H
+#define _TELNET_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Print.h"
+
+// Telnet commands
+#define T_SE        0xf0
+#define T_SB        0xfa
+#define T_WILL      0xfb
+#define T_WONT      0xfc
+#define T_DO        0xfd
+#define T_DONT      0xfe
+#define T_IAC       0xff
+
+// Telnet options that are negotiated
+#define TELOPT_BINARY   0
+#define TELOPT_ECHO     1
+#define TELOPT_SGA      3
+#define TELOPT_TTYPE    24
+#define TELOPT_NAWS     31
+
+#define TELNET_SB_MAX   32      // Longest subnegotiation that is kept, the rest is dropped
+#define TELNET_OPTIONS  32      // Options 0..31 are tracked, all others are refused
+
+/*
+ * Resumable telnet decoder/encoder.  Data from the network goes through
+ * decode(), which can be handed any fragment of the stream; a command split
+ * across two calls is finished on the next call.  Data for the network goes
+ * through escape().  Option negotiation follows the RFC 1143 Q-method so
+ * the two sides can never get into a negotiation loop.  Replies are written
+ * to the peer set with begin().
+ */
+class Telnet
+{
+private:
+    enum DecodeState
+    {
+        S_DATA,         // Passing data through
+        S_CR,           // Seen a CR, drop a NUL that follows it
+        S_IAC,          // Seen IAC
+        S_OPTION,       // Seen IAC WILL/WONT/DO/DONT, waiting for the option
+        S_SB,           // In a subnegotiation
+        S_SB_IAC        // Seen IAC in a subnegotiation
+    };
+
+    // RFC 1143 option states, with the queue bit kept separately
+    enum QState
+    {
+        Q_NO,
+        Q_YES,
+        Q_WANTNO,
+        Q_WANTYES
+    };
+
+    struct Option
+    {
+        uint8_t us : 2;         // QState of the option on this side
+        uint8_t usq : 1;        // OPPOSITE queued for us
+        uint8_t him : 2;        // QState of the option on the remote side
+        uint8_t himq : 1;       // OPPOSITE queued for him
+    };
+
+    Print *peer = nullptr;
+    DecodeState state = S_DATA;
+    uint8_t command = 0;
+    uint8_t sb[TELNET_SB_MAX];
+    size_t sbLen = 0;
+    Option options[TELNET_OPTIONS];
+    const char *terminalType = "ANSI";
+    uint16_t width = 80, height = 24;
+
+    bool acceptUs(uint8_t option);
+    bool acceptHim(uint8_t option);
+    void send(uint8_t cmd, uint8_t option);
+    void sendNAWS();
+    void receivedWill(uint8_t option);
+    void receivedWont(uint8_t option);
+    void receivedDo(uint8_t option);
+    void receivedDont(uint8_t option);
+    void subnegotiation();
+
+public:
+    Telnet() { reset(); }
+
+    /**
+     * Set where negotiation replies go and reset all state for a new connection
+     */
+    void begin(Print *peer);
+
+    /**
+     * Forget all negotiated options and any partial command
+     */
+    void reset();
+
+    /**
+     * Terminal type reported for TTYPE and window size reported for NAWS
+     */
+    void setTerminalType(const char *type) { terminalType = type; }
+    void setWindowSize(uint16_t columns, uint16_t rows);
+
+    /**
+     * Ask to enable or disable an option on this side (WILL/WONT) or on the remote side (DO/DONT)
+     */
+    void requestUs(uint8_t option, bool enable);
+    void requestHim(uint8_t option, bool enable);
+
+    bool usEnabled(uint8_t option) { return option < TELNET_OPTIONS && options[option].us == Q_YES; }
+    bool himEnabled(uint8_t option) { return option < TELNET_OPTIONS && options[option].him == Q_YES; }
+
+    /**
+     * Strip telnet commands from len bytes of network data in a single pass,
+     * writing the terminal data to out (which may be the same as in).
+     * Returns the number of bytes written to out, which is never more than len
+     */
+    size_t decode(const uint8_t *in, size_t len, uint8_t *out);
+
+    /**
+     * Double every IAC in len bytes of terminal data, writing at most outSize
+     * bytes to out.  used is set to how many bytes of in were consumed.
+     * Returns the number of bytes written to out
+     */
+    size_t escape(const uint8_t *in, size_t len, uint8_t *out, size_t outSize, size_t *used);
+};
+
+#endif // _TELNET_H
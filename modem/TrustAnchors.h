@@ -0,0 +1,21 @@
+/*
+  TrustAnchors.h - root certificates TLS servers are checked against
+  Stefan Wessels, 2023
+*/
+#ifndef _TRUSTANCHORS_H
+#define _TRUSTANCHORS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct
+{
+    const uint8_t *der;
+    size_t size;
+} TrustAnchor;
+
+// The roots behind most web sites, as DER in flash
+extern const TrustAnchor trustAnchors[];
+extern const size_t trustAnchorCount;
+
+#endif // _TRUSTANCHORS_H
@@ -19,6 +19,7 @@
 
 #include "WiFi.h"
 #include <lwip/netdb.h>
+#include <lwip/dns.h>
 
 int NameSort(_wifi_node *lhs, _wifi_node *rhs)
 {
@@ -46,6 +47,18 @@ int scanResult(void *, const cyw43_ev_scan_result_t *result)
 wcList<_wifi_node> WiFiClass::_wifi_nodes;
 int WiFiClass::itf = CYW43_ITF_STA;
 String WiFiClass::wifi_ssid = "";
+String WiFiClass::wifi_pass = "";
+uint32_t WiFiClass::wifi_auth = CYW43_AUTH_OPEN;
+bool WiFiClass::roaming = true;
+bool WiFiClass::roamScanning = false;
+int32_t WiFiClass::roamRssi = 0;
+int32_t WiFiClass::roamBestRssi = 0;
+uint8_t WiFiClass::roamBssid[6];
+uint8_t WiFiClass::roamTarget[6];
+uint16_t WiFiClass::roamChannel = 0;
+absolute_time_t WiFiClass::roamNextCheck = nil_time;
+absolute_time_t WiFiClass::roamNextScan = nil_time;
+dns_entry_t WiFiClass::dnsCache[DNS_CACHE_ENTRIES];
 
 WiFiClass::WiFiClass()
 {
@@ -62,23 +75,33 @@ char *WiFiClass::firmwareVersion()
     return nullptr;
 }
 
-int WiFiClass::begin(const char *ssid)
+/*
+ * Remember how the network was joined, so roam() can join another AP of it
+ */
+int WiFiClass::join(const char *ssid, const char *key, uint32_t auth)
 {
-
     wifi_ssid = ssid;
-    return cyw43_arch_wifi_connect_timeout_ms(ssid, nullptr, CYW43_AUTH_OPEN, WIFI_CONNECTION_MS);
+    wifi_pass = key ? key : "";
+    wifi_auth = auth;
+    roamScanning = false;
+    roamRssi = 0;
+    roamNextScan = nil_time;
+    return cyw43_arch_wifi_connect_timeout_ms(ssid, key, auth, WIFI_CONNECTION_MS);
+}
+
+int WiFiClass::begin(const char *ssid)
+{
+    return join(ssid, nullptr, CYW43_AUTH_OPEN);
 }
 
 int WiFiClass::begin(const char *ssid, uint8_t key_idx, const char *key)
 {
-    wifi_ssid = ssid;
-    return cyw43_arch_wifi_connect_timeout_ms(ssid, key, CYW43_AUTH_WPA_TKIP_PSK, WIFI_CONNECTION_MS);
+    return join(ssid, key, CYW43_AUTH_WPA_TKIP_PSK);
 }
 
 int WiFiClass::begin(const char *ssid, const char *passphrase)
 {
-    wifi_ssid = ssid;
-    return cyw43_arch_wifi_connect_timeout_ms(ssid, passphrase, CYW43_AUTH_WPA2_AES_PSK, WIFI_CONNECTION_MS);
+    return join(ssid, passphrase, CYW43_AUTH_WPA2_AES_PSK);
 }
 
 int WiFiClass::disconnect()
@@ -136,26 +159,206 @@ int8_t WiFiClass::scanNetworks()
     return _wifi_nodes.NumElements();
 }
 
+int32_t WiFiClass::RSSI()
+{
+    int32_t rssi;
+    if (status() != CYW43_LINK_UP || cyw43_wifi_get_rssi(&cyw43_state, &rssi))
+        return 0;
+    return rssi;
+}
+
+uint8_t *WiFiClass::BSSID(uint8_t *bssid)
+{
+    if (status() != CYW43_LINK_UP || cyw43_wifi_get_bssid(&cyw43_state, bssid))
+        memset(bssid, 0, 6);
+    return bssid;
+}
+
+/*
+ * Keep the strongest AP of the scan that is not the one in use
+ */
+int WiFiClass::roamScanResult(void *, const cyw43_ev_scan_result_t *result)
+{
+    if (result && result->ssid_len == wifi_ssid.length() && !memcmp(result->ssid, wifi_ssid.c_str(), result->ssid_len) &&
+        memcmp(result->bssid, roamBssid, sizeof(roamBssid)) && result->rssi > roamBestRssi)
+    {
+        roamBestRssi = result->rssi;
+        memcpy(roamTarget, result->bssid, sizeof(roamTarget));
+        roamChannel = result->channel;
+    }
+    return 0;
+}
+
+void WiFiClass::roam()
+{
+    if (!roaming || !wifi_ssid.length() || status() != CYW43_LINK_UP)
+    {
+        roamRssi = 0;
+        return;
+    }
+
+    // The firmware scans the other channels between serving this one
+    if (roamScanning)
+    {
+        if (cyw43_wifi_scan_active(&cyw43_state))
+            return;
+        roamScanning = false;
+        if (roamChannel)
+        {
+            // Joining by BSSID moves to that AP; the link drops and comes
+            // back up with the netif and its sockets untouched
+            cyw43_wifi_join(&cyw43_state, wifi_ssid.length(), (const uint8_t *)wifi_ssid.c_str(), wifi_pass.length(),
+                            (const uint8_t *)wifi_pass.c_str(), wifi_auth, roamTarget, roamChannel);
+            roamRssi = 0;
+        }
+        return;
+    }
+
+    if (!time_reached(roamNextCheck))
+        return;
+    roamNextCheck = make_timeout_time_ms(ROAM_CHECK_MS);
+
+    int32_t rssi;
+    if (cyw43_wifi_get_rssi(&cyw43_state, &rssi))
+        return;
+    roamRssi = roamRssi ? (roamRssi * (ROAM_AVERAGE - 1) + rssi) / ROAM_AVERAGE : rssi;
+    if (roamRssi >= ROAM_RSSI_WEAK || !time_reached(roamNextScan))
+        return;
+
+    // Only this SSID is scanned for, to keep the time off channel short
+    cyw43_wifi_scan_options_t scan_options = {0};
+    scan_options.ssid_len = wifi_ssid.length();
+    memcpy(scan_options.ssid, wifi_ssid.c_str(), scan_options.ssid_len);
+    if (cyw43_wifi_get_bssid(&cyw43_state, roamBssid))
+        return;
+    roamBestRssi = roamRssi + ROAM_RSSI_MARGIN;
+    roamChannel = 0;
+    roamNextScan = make_timeout_time_ms(ROAM_SCAN_MS);
+    roamScanning = !cyw43_wifi_scan(&cyw43_state, &scan_options, nullptr, roamScanResult);
+}
+
 uint8_t WiFiClass::status()
 {
     return cyw43_wifi_link_status(&cyw43_state, itf);
 }
 
-int WiFiClass::hostByName(const char *aHostname, IPAddress &aResult)
+/*
+ * lwIP's answer to a lookup dnsStart began.  Runs in the lwIP thread
+ */
+static void dnsFound(const char *name, const ip_addr_t *ipaddr, void *arg)
 {
-    struct hostent *host = gethostbyname(aHostname);
-    if (host)
+    dns_entry_t *entry = (dns_entry_t *)arg;
+
+    if (ipaddr)
     {
-        aResult[0] = host->h_addr_list[0][0];
-        aResult[1] = host->h_addr_list[0][1];
-        aResult[2] = host->h_addr_list[0][2];
-        aResult[3] = host->h_addr_list[0][3];
-        return 1;
+        entry->addr = ip4_addr_get_u32(ip_2_ip4(ipaddr));
+        entry->state = DNS_FOUND;
     }
     else
-        aResult.fromString("0.0.0.0");
+    {
+        entry->expires = make_timeout_time_ms(DNS_NEGATIVE_MS);
+        entry->state = DNS_FAILED;
+    }
+}
 
-    return 0;
+/*
+ * Look name up, unless it is already being looked up or recently failed to
+ * resolve.  lwIP answers at once from its table if it has the name, and
+ * the TTL has not run out.  Returns the entry that has, or will get, the
+ * answer, or nullptr if every entry is waiting on an answer
+ */
+dns_entry_t *WiFiClass::dnsStart(const char *name)
+{
+    dns_entry_t *entry = nullptr, *spare = nullptr;
+    ip_addr_t addr;
+    err_t err;
+
+    if (strlen(name) >= DNS_NAME_SIZE)
+        return nullptr;
+    for (int i = 0; i < DNS_CACHE_ENTRIES; i++)
+    {
+        dns_entry_t *e = &dnsCache[i];
+        if (e->state != DNS_EMPTY && !strcasecmp(e->name, name))
+        {
+            entry = e;
+            break;
+        }
+        // Reuse an empty entry, or else the one unused longest
+        if (e->state == DNS_PENDING || (spare && spare->state == DNS_EMPTY))
+            continue;
+        if (!spare || e->state == DNS_EMPTY || absolute_time_diff_us(e->used, spare->used) > 0)
+            spare = e;
+    }
+    if (entry)
+    {
+        if (entry->state == DNS_PENDING || (entry->state == DNS_FAILED && !time_reached(entry->expires)))
+            return entry;
+    }
+    else
+    {
+        if (!(entry = spare))
+            return nullptr;
+        strcpy(entry->name, name);
+    }
+    entry->used = get_absolute_time();
+    entry->state = DNS_PENDING;
+
+    cyw43_arch_lwip_begin();
+    err = dns_gethostbyname(entry->name, &addr, dnsFound, entry);
+    cyw43_arch_lwip_end();
+
+    if (err == ERR_OK)
+    {
+        entry->addr = ip4_addr_get_u32(ip_2_ip4(&addr));
+        entry->state = DNS_FOUND;
+    }
+    else if (err == ERR_MEM)
+    {
+        // Too many lookups at once, not an answer
+        entry->state = DNS_EMPTY;
+    }
+    else if (err != ERR_INPROGRESS)
+    {
+        entry->expires = make_timeout_time_ms(DNS_NEGATIVE_MS);
+        entry->state = DNS_FAILED;
+    }
+    return entry;
+}
+
+int WiFiClass::resolve(const char *aHostname, IPAddress &aResult)
+{
+    if (aResult.fromString(aHostname))
+        return 1;
+    aResult.fromString("0.0.0.0");
+
+    dns_entry_t *entry = dnsStart(aHostname);
+    if (!entry)
+        return 0;
+    if (entry->state == DNS_PENDING)
+        return -1;
+    if (entry->state != DNS_FOUND)
+        return 0;
+    aResult = entry->addr;
+
+    return 1;
+}
+
+int WiFiClass::hostByName(const char *aHostname, IPAddress &aResult)
+{
+    absolute_time_t timeout = make_timeout_time_ms(DNS_WAIT_MS);
+    int ret;
+
+    while ((ret = resolve(aHostname, aResult)) < 0 && !time_reached(timeout))
+        sleep_ms(1);
+
+    return ret > 0;
+}
+
+void WiFiClass::prefetch(const char *aHostname)
+{
+    IPAddress addr;
+    if (!addr.fromString(aHostname))
+        dnsStart(aHostname);
 }
 
 WiFiClass WiFi;
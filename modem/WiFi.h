@@ -24,11 +24,23 @@
 #define WIFI_CONNECTION_MS  10000
 #define MAX_SOCK_NUM        4
 
+#define ROAM_CHECK_MS       1000    // How often the signal is looked at
+#define ROAM_RSSI_WEAK      -72     // dBm, averaged, below which other APs are looked for
+#define ROAM_RSSI_MARGIN    8       // dB an AP must be stronger by to move to it
+#define ROAM_SCAN_MS        20000   // Least time between roaming scans
+#define ROAM_AVERAGE        4       // Readings the RSSI is averaged over
+
+#define DNS_CACHE_ENTRIES   16      // Names being looked up, or known not to resolve
+#define DNS_NAME_SIZE       80      // Longest name, DNS_MAX_NAME_LENGTH in lwipopts.h
+#define DNS_NEGATIVE_MS     30000   // How long a name that did not resolve is not asked about
+#define DNS_WAIT_MS         10000   // Longest hostByName waits for an answer
+
 
 #include <inttypes.h>
 #include "IPAddress.h"
 #include "WiFiClient.h"
 #include "pico/cyw43_arch.h"
+#include "pico/time.h"
 #include "wcList.h"
 
 /*
@@ -43,13 +55,61 @@ public:
 };
 
 
+/*
+ * A name lookup with lwIP's dns_gethostbyname.  The callback fills in the
+ * answer, so many names can be looked up at once without waiting
+ */
+enum dns_state_t
+{
+    DNS_EMPTY,
+    DNS_PENDING,
+    DNS_FOUND,
+    DNS_FAILED
+};
+
+typedef struct
+{
+    char name[DNS_NAME_SIZE];
+    volatile dns_state_t state;
+    uint32_t addr;
+    absolute_time_t expires;    // When a failed name may be asked about again
+    absolute_time_t used;
+} dns_entry_t;
+
+
+/*
+ * Roaming: when several APs share the SSID, roam() keeps an average of the
+ * RSSI and once it is weak, scans for the SSID in the background.  If an AP
+ * is clearly stronger, the station joins it by BSSID.  The netif, its IP
+ * address and the lwIP sockets are left alone; lwIP asks DHCP for the same
+ * address again when the link comes back up, so open connections only see
+ * a pause.
+ */
 class WiFiClass
 {
 private:
+    static String wifi_pass;
+    static uint32_t wifi_auth;
+
+    static bool roamScanning;
+    static int32_t roamRssi;                    // Average, 0 if there is none yet
+    static int32_t roamBestRssi;
+    static uint8_t roamBssid[6];                // The AP in use when the scan started
+    static uint8_t roamTarget[6];
+    static uint16_t roamChannel;
+    static absolute_time_t roamNextCheck, roamNextScan;
+
+    static int roamScanResult(void *, const cyw43_ev_scan_result_t *result);
+
+    static dns_entry_t dnsCache[DNS_CACHE_ENTRIES];
+    static dns_entry_t *dnsStart(const char *name);
+    int join(const char *ssid, const char *key, uint32_t auth);
+
 public:
     static wcList<_wifi_node> _wifi_nodes;
     static int itf;
     static String wifi_ssid;
+    static bool roaming;                        // Look for a stronger AP when the signal is weak
 
     WiFiClass();
 
@@ -131,6 +191,26 @@ public:
      */
     char *SSID();
 
+    /*
+     * The signal strength of the AP in use, in dBm
+     *
+     * return: RSSI, 0 if not associated
+     */
+    int32_t RSSI();
+
+    /*
+     * Get the MAC address of the AP in use
+     *
+     * return: pointer to bssid, 6 bytes
+     */
+    uint8_t *BSSID(uint8_t *bssid);
+
+    /*
+     * Call often.  Watches the signal and moves to a stronger AP with the
+     * same SSID, without blocking
+     */
+    void roam();
+
      /*
      * Start scan WiFi networks available
      *
@@ -147,6 +227,9 @@ public:
 
     /*
      * Resolve the given hostname to an IP address.
+     * Answers come from lwIP's DNS table for as long as their TTL lasts, so
+     * only a name not looked up recently waits for the DNS server.  A name
+     * that did not resolve fails at once for DNS_NEGATIVE_MS.
      * param aHostname: Name to be resolved
      * param aResult: IPAddress structure to store the returned IP address
      * result: 1 if aIPAddrString was successfully converted to an IP address,
@@ -154,6 +237,18 @@ public:
      */
     int hostByName(const char *aHostname, IPAddress &aResult);
 
+    /*
+     * hostByName without the wait.  Returns 1 with aResult set, 0 if the
+     * name does not resolve and -1 while the answer is still to come
+     */
+    int resolve(const char *aHostname, IPAddress &aResult);
+
+    /*
+     * Start looking up a name that is likely to be asked for soon, without
+     * waiting for the answer
+     */
+    void prefetch(const char *aHostname);
+
     friend class WiFiClient;
 };
 
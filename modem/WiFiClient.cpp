@@ -19,7 +19,13 @@
 
 #include "WiFi.h"
 #include "WiFiClient.h"
+#include "SDImage.h"
+#include "SSHKey.h"
+#include "TrustAnchors.h"
 #include <lwip/sockets.h>
+#include <errno.h>
+#include <stdio.h>
+#include <wolfssl/wolfcrypt/sha256.h>
 
 // #ifdef USE_UART
 // #include "Serial.h"
@@ -28,9 +34,29 @@
 
 static byte userPassword[256];
 
-static int wsUserAuth(byte authType,
-                      WS_UserAuthData *authData,
-                      void *ctx)
+WOLFSSH_CTX *WiFiClient::ctx = NULL;
+WOLFSSL_CTX *WiFiClient::tlsCtx = NULL;
+
+// The last TLS session with a host, by host:port, to resume the next call with
+typedef struct
+{
+    char host[KNOWN_HOST_NAME];
+    WOLFSSL_SESSION *session;
+} TlsSession;
+
+static TlsSession tlsSessions[TLS_SESSIONS];
+static int tlsSessionNext = 0;   // Replaced next when a new host needs a slot
+
+// A host key, kept as its SHA-256, by host:port
+typedef struct
+{
+    char host[KNOWN_HOST_NAME];
+    uint8_t hash[WC_SHA256_DIGEST_SIZE];
+} KnownHost;
+
+int wsUserAuth(byte authType,
+               WS_UserAuthData *authData,
+               void *ctx)
 {
     int ret = WOLFSSH_USERAUTH_SUCCESS;
 
@@ -48,43 +74,30 @@ static int wsUserAuth(byte authType,
     printf("wolfSSH requesting to use type %d\n", authType);
 #endif
 
-    // /* Wait for request of public key on names known to have one */
-    // if ((authData->type & WOLFSSH_USERAUTH_PUBLICKEY) &&
-    //         authData->username != NULL &&
-    //         authData->usernameSz > 0) {
-
-    //     /* in the case that the name is hansel or in the case that the user
-    //      * passed in a public key file, use public key auth */
-    //     if ((XSTRNCMP((char*)authData->username, "hansel",
-    //             authData->usernameSz) == 0) ||
-    //         pubKeyName != NULL || certName != NULL) {
-
-    //         if (authType == WOLFSSH_USERAUTH_PASSWORD) {
-    //             printf("rejecting password type with %s in favor of pub key\n",
-    //                 (char*)authData->username);
-    //             return WOLFSSH_USERAUTH_FAILURE;
-    //         }
-    //     }
-    // }
-
-    // if (authType == WOLFSSH_USERAUTH_PUBLICKEY) {
-    //     WS_UserAuthData_PublicKey* pk = &authData->sf.publicKey;
-
-    //     pk->publicKeyType = userPublicKeyType;
-    //     pk->publicKeyTypeSz = userPublicKeyTypeSz;
-    //     pk->publicKey = userPublicKey;
-    //     pk->publicKeySz = userPublicKeySz;
-    //     pk->privateKey = userPrivateKey;
-    //     pk->privateKeySz = userPrivateKeySz;
+    WiFiClient *client = (WiFiClient *)ctx;
 
-    //     ret = WOLFSSH_USERAUTH_SUCCESS;
-    // }
-    // else
+    /* With a key of its own, the modem offers it once before the password */
+    if (authType == WOLFSSH_USERAUTH_PUBLICKEY)
+    {
+        WS_UserAuthData_PublicKey *pk = &authData->sf.publicKey;
+
+        if (!SSHKey::loaded() || client->keyTried)
+            return WOLFSSH_USERAUTH_FAILURE;
+        client->keyTried = true;
+        pk->publicKeyType = (const byte *)SSHKey::type();
+        pk->publicKeyTypeSz = (word32)strlen(SSHKey::type());
+        pk->publicKey = SSHKey::publicBlob(&pk->publicKeySz);
+        pk->privateKey = SSHKey::privateDer(&pk->privateKeySz);
+    }
+    else
     if (authType == WOLFSSH_USERAUTH_PASSWORD)
     {
-        const char *defaultPassword = (const char *)ctx;
+        const char *defaultPassword = client->password;
         word32 passwordSz = 0;
 
+        if (SSHKey::loaded() && !client->keyTried && (authData->type & WOLFSSH_USERAUTH_PUBLICKEY))
+            return WOLFSSH_USERAUTH_FAILURE;
+
         if (defaultPassword != NULL)
         {
             passwordSz = (word32)strlen(defaultPassword);
@@ -125,15 +138,10 @@ static int wsPublicKeyCheck(const byte *pubKey, word32 pubKeySz, void *ctx)
     int ret = 0;
 
 #ifdef DEBUG_WOLFSSH
-    printf("Sample public key check callback\n"
+    printf("Public key check callback\n"
            "  public key = %p\n"
-           "  public key size = %u\n"
-           "  ctx = %s\n",
-           pubKey, pubKeySz, (const char *)ctx);
-#else
-    (void)pubKey;
-    (void)pubKeySz;
-    (void)ctx;
+           "  public key size = %u\n",
+           pubKey, pubKeySz);
 #endif
 
 #ifdef WOLFSSH_CERTS
@@ -185,28 +193,250 @@ static int wsPublicKeyCheck(const byte *pubKey, word32 pubKeySz, void *ctx)
 #endif
 #endif
 
+    if (ret == 0)
+        ret = ((WiFiClient *)ctx)->checkHostKey(pubKey, pubKeySz);
+
     return ret;
 }
 
 WiFiClient::WiFiClient() : _socket(NA_STATE)
 {
+    host[0] = '\0';
 }
 
 WiFiClient::WiFiClient(uint8_t sock) : _socket(sock)
 {
+    host[0] = '\0';
+}
+
+/*
+ * Trust a host's key the first time it is seen and refuse any other key from
+ * that host:port after that.  Without an SD card every key is accepted
+ */
+int WiFiClient::checkHostKey(const uint8_t *pubKey, uint32_t pubKeySz)
+{
+    KnownHost seen, known;
+    FIL fil;
+    UINT done = 0;
+    int ret = 0;
+
+    memset(&seen, 0, sizeof(seen));
+    strncpy(seen.host, host, KNOWN_HOST_NAME - 1);
+    if (wc_Sha256Hash(pubKey, pubKeySz, seen.hash) != 0)
+        return -1;
+
+    if (SDImage::mount() != FR_OK || f_open(&fil, KNOWN_HOSTS_FILE, FA_READ | FA_WRITE | FA_OPEN_ALWAYS) != FR_OK)
+        return 0;
+    while (f_read(&fil, &known, sizeof(known), &done) == FR_OK && done == sizeof(known))
+    {
+        if (!strcmp(known.host, seen.host))
+        {
+            hostKeyChanged = memcmp(known.hash, seen.hash, sizeof(seen.hash)) != 0;
+            ret = hostKeyChanged ? -1 : 0;
+            break;
+        }
+    }
+    // Not known, and the file is at its end, so remember it
+    if (done != sizeof(known))
+        f_write(&fil, &seen, sizeof(seen), &done);
+    f_close(&fil);
+
+    return ret;
+}
+
+/*
+ * wolfSSL's I/O.  Reads never block, so the handshake is moved along by
+ * tlsPoll, and a partial record is left for wolfSSL_read to pick up on a
+ * later call
+ */
+int tlsRecv(WOLFSSL *ssl, char *buf, int sz, void *ctx)
+{
+    WiFiClient *client = (WiFiClient *)ctx;
+    int ret = recv(client->_socket, buf, sz, MSG_DONTWAIT);
+
+    if (ret > 0)
+        return ret;
+    if (!ret)
+        return WOLFSSL_CBIO_ERR_CONN_CLOSE;
+    if (errno == EWOULDBLOCK || errno == EAGAIN)
+        return WOLFSSL_CBIO_ERR_WANT_READ;
+    return WOLFSSL_CBIO_ERR_GENERAL;
+}
+
+int tlsSend(WOLFSSL *ssl, char *buf, int sz, void *ctx)
+{
+    WiFiClient *client = (WiFiClient *)ctx;
+    int ret = send(client->_socket, buf, sz, 0);
+
+    if (ret >= 0)
+        return ret;
+    if (errno == EPIPE || errno == ECONNRESET)
+        return WOLFSSL_CBIO_ERR_CONN_CLOSE;
+    return WOLFSSL_CBIO_ERR_GENERAL;
+}
+
+static TlsSession *tlsSessionFind(const char *host)
+{
+    if (!host[0])
+        return NULL;
+    for (int i = 0; i < TLS_SESSIONS; i++)
+    {
+        if (tlsSessions[i].session && !strcmp(tlsSessions[i].host, host))
+            return &tlsSessions[i];
+    }
+    return NULL;
+}
+
+/*
+ * Keep the session the call to host ended with, in place of an older one
+ */
+static void tlsSessionSave(const char *host, WOLFSSL_SESSION *session)
+{
+    TlsSession *saved = tlsSessionFind(host);
+
+    if (!session)
+        return;
+    if (!host[0])
+    {
+        wolfSSL_SESSION_free(session);
+        return;
+    }
+    if (!saved)
+    {
+        saved = &tlsSessions[tlsSessionNext];
+        tlsSessionNext = (tlsSessionNext + 1) % TLS_SESSIONS;
+        strcpy(saved->host, host);
+    }
+    if (saved->session)
+        wolfSSL_SESSION_free(saved->session);
+    saved->session = session;
+}
+
+/*
+ * Wrap the connection tcp_connect made in TLS, waiting up to
+ * CONNECT_TIMEOUT_MS for the handshake
+ */
+int WiFiClient::tls_connect(const char *hostName)
+{
+    int ret;
+    absolute_time_t deadline = make_timeout_time_ms(CONNECT_TIMEOUT_MS);
+
+    if (!tlsStart(hostName))
+        return 0;
+    while ((ret = tlsPoll()) == CONNECT_WAIT && !time_reached(deadline))
+        sleep_ms(1);
+    return ret == 1;
 }
 
+/*
+ * Begin the TLS handshake, without waiting.  hostName is what the server's
+ * certificate must be for, and is sent as SNI.  A host called before, and
+ * still in tlsSessions, is offered its last session, or ticket, to resume.
+ * tlsPoll moves the handshake along
+ */
+int WiFiClient::tlsStart(const char *hostName)
+{
+    TlsSession *saved;
+
+    tlsResumed = false;
+    // The trust anchors are loaded into the context once, and it is kept
+    if (!tlsCtx)
+    {
+        wolfSSL_Init();
+        if (!(tlsCtx = wolfSSL_CTX_new(wolfSSLv23_client_method())))
+            return 0;
+        for (size_t i = 0; i < trustAnchorCount; i++)
+            wolfSSL_CTX_load_verify_buffer(tlsCtx, trustAnchors[i].der, trustAnchors[i].size, WOLFSSL_FILETYPE_ASN1);
+        wolfSSL_CTX_set_verify(tlsCtx, WOLFSSL_VERIFY_PEER, NULL);
+        wolfSSL_CTX_UseSessionTicket(tlsCtx);
+        wolfSSL_CTX_SetIORecv(tlsCtx, tlsRecv);
+        wolfSSL_CTX_SetIOSend(tlsCtx, tlsSend);
+    }
+    if (!(ssl = wolfSSL_new(tlsCtx)))
+        return 0;
+    wolfSSL_SetIOReadCtx(ssl, this);
+    wolfSSL_SetIOWriteCtx(ssl, this);
+    wolfSSL_UseSNI(ssl, WOLFSSL_SNI_HOST_NAME, hostName, (word16)strlen(hostName));
+    wolfSSL_check_domain_name(ssl, hostName);
+    if ((saved = tlsSessionFind(host)))
+        wolfSSL_set_session(ssl, saved->session);
+    tlsHandshake = true;
+    return 1;
+}
+
+/*
+ * Call until it stops returning CONNECT_WAIT.  Returns 1 once the handshake
+ * is done and 0 if it failed
+ */
+int WiFiClient::tlsPoll()
+{
+    if (!ssl)
+        return 0;
+    if (!tlsHandshake)
+        return 1;
+    int ret = wolfSSL_connect(ssl);
+    if (ret != WOLFSSL_SUCCESS)
+    {
+        int err = wolfSSL_get_error(ssl, ret);
+        return (err == WOLFSSL_ERROR_WANT_READ || err == WOLFSSL_ERROR_WANT_WRITE) ? CONNECT_WAIT : 0;
+    }
+    tlsHandshake = false;
+    tlsResumed = wolfSSL_session_reused(ssl);
+    return 1;
+}
+
+/*
+ * Wrap the connection tcp_connect made in SSH, waiting up to
+ * CONNECT_TIMEOUT_MS for the handshake and the log in
+ */
 int WiFiClient::ssh_connect(const char *username, const char *password)
 {
-    String cmd = "bash";
-    if (!(ctx = wolfSSH_CTX_new(WOLFSSH_ENDPOINT_CLIENT, NULL)))
+    int ret;
+    absolute_time_t deadline = make_timeout_time_ms(CONNECT_TIMEOUT_MS);
+
+    if (!sshStart(username, password))
         return 0;
-    wolfSSH_SetUserAuth(ctx, wsUserAuth);
+    while ((ret = sshPoll()) == CONNECT_WAIT && !time_reached(deadline))
+        sleep_ms(1);
+    return ret == 1;
+}
+
+/*
+ * A wolfSSH call on the non-blocking socket returned ret.  true if it only
+ * stopped because it would have had to wait for the socket
+ */
+static bool sshWouldBlock(WOLFSSH *ssh, int ret)
+{
+    if (ret == WS_FATAL_ERROR)
+        ret = wolfSSH_get_error(ssh);
+    return ret == WS_WANT_READ || ret == WS_WANT_WRITE;
+}
+
+/*
+ * Begin the SSH handshake, without waiting.  The socket of an SSH call never
+ * blocks, so wolfSSH_connect, and every wolfSSH read after it, returns
+ * whenever it would wait
+ */
+int WiFiClient::sshStart(const char *username, const char *password)
+{
+    String cmd = "bash";
+    hostKeyChanged = false;
+    // The context, with its algorithm setup, lasts from one call to the next
+    if (!ctx)
+    {
+        if (!(ctx = wolfSSH_CTX_new(WOLFSSH_ENDPOINT_CLIENT, NULL)))
+            return 0;
+        wolfSSH_SetUserAuth(ctx, wsUserAuth);
+        wolfSSH_CTX_SetPublicKeyCheck(ctx, wsPublicKeyCheck);
+        wolfSSH_CTX_SetWindowPacketSize(ctx, SSH_WINDOW_SIZE, SSH_MAX_PACKET);
+    }
     if (!(ssh = wolfSSH_new(ctx)))
         return 0;
-    wolfSSH_SetUserAuthCtx(ssh, (void *)password);
-    // wolfSSH_CTX_SetPublicKeyCheck(ctx, wsPublicKeyCheck);
-    // wolfSSH_SetPublicKeyCheckCtx(ssh, (void*)"You've been sampled!");
+    rxHead = rxTail = 0;
+    this->password = password;
+    keyTried = false;
+    wolfSSH_SetUserAuthCtx(ssh, (void *)this);
+    wolfSSH_SetPublicKeyCheckCtx(ssh, (void *)this);
     if (WS_SUCCESS != wolfSSH_SetUsername(ssh, username))
         return 0;
     if (WS_SUCCESS != wolfSSH_set_fd(ssh, _socket))
@@ -214,38 +444,173 @@ int WiFiClient::ssh_connect(const char *username, const char *password)
     if (WS_SUCCESS != wolfSSH_SetChannelType(ssh, WOLFSSH_SESSION_TERMINAL, NULL, 0))
     // if (WS_SUCCESS != wolfSSH_SetChannelType(ssh, WOLFSSH_SESSION_EXEC, (uint8_t*)cmd.c_str(), cmd.length()))
         return 0;
-    if (WS_SUCCESS != wolfSSH_connect(ssh))
-        return 0;
+    fcntl(_socket, F_SETFL, fcntl(_socket, F_GETFL, 0) | O_NONBLOCK);
+    sshHandshake = true;
+    return 1;
+}
 
+/*
+ * Call until it stops returning CONNECT_WAIT.  Returns 1 once logged in and
+ * the channel is open, and 0 if that failed
+ */
+int WiFiClient::sshPoll()
+{
+    if (!ssh)
+        return 0;
+    if (!sshHandshake)
+        return 1;
+    if (WS_SUCCESS != wolfSSH_connect(ssh))
+        return sshWouldBlock(ssh, WS_FATAL_ERROR) ? CONNECT_WAIT : 0;
+    sshHandshake = false;
     return 1;
 }
 
 int WiFiClient::tcp_connect(const char *host, uint16_t port)
 {
-    IPAddress remote_addr;
-    if (WiFi.hostByName(host, remote_addr))
-        return tcp_connect(remote_addr, port);
-    return 0;
+    int ret;
+
+    if (!connectStart(host, port, CONNECT_TIMEOUT_MS))
+        return 0;
+    while ((ret = connectPoll()) == CONNECT_WAIT)
+        sleep_ms(1);
+    return ret;
 }
 
 int WiFiClient::tcp_connect(IPAddress ip, uint16_t port)
 {
-    if (_socket == NA_STATE)
+    int ret;
+
+    if (!connectStart(ip, port, CONNECT_TIMEOUT_MS))
+        return 0;
+    while ((ret = connectPoll()) == CONNECT_WAIT)
+        sleep_ms(1);
+    return ret;
+}
+
+/*
+ * Begin connecting, without waiting.  connectPoll moves the connection
+ * along and tells when it is made, or has failed, or timeoutMs has passed
+ */
+int WiFiClient::connectStart(IPAddress ip, uint16_t port, uint32_t timeoutMs)
+{
+    if (_socket != NA_STATE || connecting)
+        return 0;
+    tlsResumed = false;
+    host[0] = '\0';
+    remote = ip;
+    remotePort = port;
+    resolving = false;
+    attempt = -1;
+    connectDeadline = make_timeout_time_ms(timeoutMs);
+    connecting = true;
+    return 1;
+}
+
+int WiFiClient::connectStart(const char *host, uint16_t port, uint32_t timeoutMs)
+{
+    if (!connectStart(IPAddress(), port, timeoutMs))
+        return 0;
+    snprintf(this->host, sizeof(this->host), "%s:%u", host, port);
+    resolving = true;
+    return 1;
+}
+
+/*
+ * Start the non-blocking connect to remote
+ */
+bool WiFiClient::connectBegin()
+{
+    struct sockaddr_in serv_addr;
+    int s = socket(AF_INET, SOCK_STREAM, 0);
+
+    if (s < 0)
+        return false;
+    fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK);
+    memset(&serv_addr, 0, sizeof(serv_addr));
+    serv_addr.sin_family = AF_INET;
+    serv_addr.sin_addr.s_addr = remote;
+    serv_addr.sin_port = htons(remotePort);
+    if (connect(s, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0 && errno != EINPROGRESS)
     {
-        struct sockaddr_in serv_addr;
-        memset(&serv_addr, '0', sizeof(serv_addr));
-        _socket = socket(AF_INET, SOCK_STREAM, 0);
-        if (_socket < 0)
+        close(s);
+        return false;
+    }
+    attempt = s;
+    return true;
+}
+
+/*
+ * Close the socket if it is still connecting
+ */
+void WiFiClient::connectEnd()
+{
+    if (attempt >= 0)
+        close(attempt);
+    attempt = -1;
+    resolving = false;
+    connecting = false;
+}
+
+/*
+ * Call until it stops returning CONNECT_WAIT.  Returns 1 once connected and
+ * 0 if the connection failed or timed out.  There is one SYN, left to
+ * lwIP's retransmits, so a slow host is not sent a duplicate connection; the
+ * deadline from connectStart (S7 when dialing) is the only limit.  A refused
+ * connect ends at once
+ */
+int WiFiClient::connectPoll()
+{
+    struct pollfd fd;
+
+    if (!connecting)
+        return _socket != NA_STATE;
+    if (time_reached(connectDeadline))
+    {
+        connectEnd();
+        return 0;
+    }
+
+    if (resolving)
+    {
+        char name[KNOWN_HOST_NAME];
+        strcpy(name, host);
+        *strrchr(name, ':') = '\0';
+        int found = WiFi.resolve(name, remote);
+        if (found < 0)
+            return CONNECT_WAIT;
+        if (!found)
         {
-            _socket = NA_STATE;
-            return _socket;
+            connectEnd();
+            return 0;
         }
-        serv_addr.sin_family = AF_INET;
-        serv_addr.sin_addr.s_addr = ip;
-        serv_addr.sin_port = htons(port);
-        return connect(_socket, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0 ? 0 : 1;
+        resolving = false;
+    }
+
+    if (attempt < 0 && !connectBegin())
+    {
+        connectEnd();
+        return 0;
+    }
+
+    fd.fd = attempt;
+    fd.events = POLLOUT;
+    fd.revents = 0;
+    if (poll(&fd, 1, 0) <= 0)
+        return CONNECT_WAIT;
+    int err = 0;
+    socklen_t len = sizeof(err);
+    getsockopt(attempt, SOL_SOCKET, SO_ERROR, &err, &len);
+    if (err || !(fd.revents & POLLOUT))
+    {
+        connectEnd();
+        return 0;
     }
-    return NA_STATE;
+    // Back to blocking, as the rest of WiFiClient expects
+    _socket = attempt;
+    attempt = -1;
+    fcntl(_socket, F_SETFL, fcntl(_socket, F_GETFL, 0) & ~O_NONBLOCK);
+    connectEnd();
+    return 1;
 }
 
 size_t WiFiClient::Write(uint8_t b)
@@ -255,13 +620,21 @@ size_t WiFiClient::Write(uint8_t b)
 
 size_t WiFiClient::Write(const uint8_t *buf, size_t size)
 {
-    if (_socket >= MAX_SOCK_NUM)
+    if (_socket == NA_STATE)
     {
         setWriteError();
         return -1;
     }
 
-    if (!ssh)
+    if (ssl)
+    {
+        if (wolfSSL_write(ssl, buf, size) != (int)size)
+        {
+            setWriteError();
+            return -1;
+        }
+    }
+    else if (!ssh)
     {
         if (write(_socket, buf, size) < 0)
         {
@@ -273,10 +646,23 @@ size_t WiFiClient::Write(const uint8_t *buf, size_t size)
     {
         /* lock SSH structure access */
         // wc_LockMutex(&args->lock);
-        if (wolfSSH_stream_send(ssh, (uint8_t *)buf, size) <= 0)
+        // A send is cut short at the server's window or packet size, and
+        // waits, as a plain socket write would, while the socket is full
+        absolute_time_t deadline = make_timeout_time_ms(CONNECT_TIMEOUT_MS);
+        for (size_t sent = 0; sent < size;)
         {
-            setWriteError();
-            return -1;
+            int ret = wolfSSH_stream_send(ssh, (uint8_t *)buf + sent, size - sent);
+            if (ret <= 0 && sshWouldBlock(ssh, ret) && !time_reached(deadline))
+            {
+                sleep_ms(1);
+                continue;
+            }
+            if (ret <= 0)
+            {
+                setWriteError();
+                return -1;
+            }
+            sent += ret;
         }
         // wc_UnLockMutex(&args->lock);
     }
@@ -288,14 +674,20 @@ int WiFiClient::available()
 {
     if (_socket != NA_STATE)
     {
-        int count = 0;
-        if (!ssh)
-            ioctl(_socket, FIONREAD, &count);
+        int count;
+        if (ssl)
+        {
+            count = wolfSSL_pending(ssl);
+            if(!count)
+                count = pending();
+        }
+        else if (!ssh)
+            count = pending();
         else
         {
-            count = wolfSSH_stream_peek(ssh, NULL, 16384);
+            count = rxTail - rxHead + wolfSSH_stream_peek(ssh, NULL, SSH_WINDOW_SIZE);
             if(!count)
-                ioctl(_socket, FIONREAD, &count);
+                count = pending();
         }
         return count;
     }
@@ -303,11 +695,41 @@ int WiFiClient::available()
     return -1;
 }
 
+/*
+ * Bytes on the socket not yet read - for SSH, packets not yet decrypted
+ */
+int WiFiClient::pending()
+{
+    int count = 0;
+    ioctl(_socket, FIONREAD, &count);
+    return count;
+}
+
+/*
+ * Make sure rx has some decrypted data for Read() and peek().
+ * Returns how much it has, 0 or -1 if there is none
+ */
+int WiFiClient::sshFill()
+{
+    if (rxHead == rxTail)
+    {
+        rxHead = rxTail = 0;
+        int ret = Read(rx, SSH_RX_SIZE);
+        if (ret <= 0)
+            return ret;
+        rxTail = ret;
+    }
+    return rxTail - rxHead;
+}
+
 int WiFiClient::ssh_Read(uint8_t *buf, int size)
 {
     int ret = 0;
 
     ret = wolfSSH_stream_read(ssh, buf, size);
+    // Nothing for the channel yet, a partial packet or one of another kind
+    if (ret < 0 && sshWouldBlock(ssh, ret))
+        return 0;
     if (ret == WS_EXTDATA)
     { /* handle extended data */
         do
@@ -341,27 +763,73 @@ int WiFiClient::Read()
     if (!available())
         return -1;
 
-    if (!ssh)
+    if (ssl)
+    {
+        if (Read(&b, 1) != 1)
+            return -1;
+    }
+    else if (!ssh)
         read(_socket, &b, 1);
     else
-        ssh_Read(&b, 1);
+    {
+        if (sshFill() <= 0)
+            return -1;
+        b = rx[rxHead++];
+    }
 
     return b;
 }
 
+/*
+ * Read as many bytes as are ready, up to size, straight into buf.  Does not block.
+ * Returns the number of bytes read, 0 if nothing was ready, -1 on error
+ */
 int WiFiClient::Read(uint8_t *buf, size_t size)
 {
     int ret = 0;
 
-    if (!ssh)
+    if (ssl)
     {
-        if (ret = (read(_socket, buf, size) < 0))
-            return -1;
+        // Records are decrypted straight into buf while there is room and
+        // more of them have come in
+        do
+        {
+            int got = wolfSSL_read(ssl, buf + ret, size - ret);
+            if (got <= 0)
+            {
+                if (wolfSSL_get_error(ssl, got) == WOLFSSL_ERROR_WANT_READ)
+                    break;
+                return ret ? ret : -1;
+            }
+            ret += got;
+        } while ((size_t)ret < size && (wolfSSL_pending(ssl) || pending() > 0));
+    }
+    else if (!ssh)
+    {
+        ret = recv(_socket, buf, size, MSG_DONTWAIT);
+        if (ret < 0)
+            return (errno == EWOULDBLOCK || errno == EAGAIN) ? 0 : -1;
     }
     else
     {
-        if (ret = (ssh_Read(buf, size) < 0))
-            return -1;
+        // What Read() or peek() left in rx goes first
+        ret = rxTail - rxHead;
+        if ((size_t)ret > size)
+            ret = size;
+        memcpy(buf, rx + rxHead, ret);
+        rxHead += ret;
+
+        // Then packets are decrypted straight into buf, for as long as there
+        // is room and wolfSSH or the socket has more of them
+        while ((size_t)ret < size && (!ret || wolfSSH_stream_peek(ssh, NULL, 1) || pending() > 0))
+        {
+            int got = ssh_Read(buf + ret, size - ret);
+            if (got < 0)
+                return ret ? ret : -1;
+            if (!got)
+                break;
+            ret += got;
+        }
     }
 
     return ret;
@@ -373,6 +841,23 @@ int WiFiClient::peek()
     if (!available())
         return -1;
 
+    if (ssl)
+    {
+        if (wolfSSL_peek(ssl, &b, 1) != 1)
+            return -1;
+    }
+    else if (!ssh)
+    {
+        if (recv(_socket, &b, 1, MSG_PEEK | MSG_DONTWAIT) != 1)
+            return -1;
+    }
+    else
+    {
+        if (sshFill() <= 0)
+            return -1;
+        b = rx[rxHead];
+    }
+
     return b;
 }
 
@@ -390,15 +875,24 @@ void WiFiClient::setNoDelay(int delayState)
 
 void WiFiClient::stop()
 {
+    if (connecting)
+        connectEnd();
     if (ssh)
     {
         wolfSSH_free(ssh);
         ssh = NULL;
+        sshHandshake = false;
     }
-    if (ctx)
+    rxHead = rxTail = 0;
+    if (ssl)
     {
-        wolfSSH_CTX_free(ctx);
-        ctx = NULL;
+        // Kept so the next call to the host can resume
+        if (!tlsHandshake)
+            tlsSessionSave(host, wolfSSL_get1_session(ssl));
+        tlsHandshake = false;
+        wolfSSL_shutdown(ssl);
+        wolfSSL_free(ssl);
+        ssl = NULL;
     }
     if (_socket == NA_STATE)
         return;
@@ -417,8 +911,13 @@ uint8_t WiFiClient::connected()
     {
         uint8_t s = status();
         // SQW I am not sure about this...
-        return !(s == ENOMEM || s == ENOBUFS || s == EHOSTUNREACH || s == EINVAL || s == EADDRINUSE ||
-                 s == ENOTCONN || s == -1 || s == ECONNABORTED || s == ECONNRESET || s == ENOTCONN || s == EIO);
+        if (s == ENOMEM || s == ENOBUFS || s == EHOSTUNREACH || s == EINVAL || s == EADDRINUSE ||
+            s == ENOTCONN || s == -1 || s == ECONNABORTED || s == ECONNRESET || s == ENOTCONN || s == EIO)
+            return 0;
+        // A host, or a caller, that closed its end without an error is gone
+        // once everything it sent has been read
+        char c;
+        return available() > 0 || recv(_socket, &c, 1, MSG_PEEK | MSG_DONTWAIT) != 0;
         // uint8_t s = status();
         // return !(s == LISTEN || s == CLOSED || s == FIN_WAIT_1 ||
         // 		s == FIN_WAIT_2 || s == TIME_WAIT ||
@@ -449,3 +948,13 @@ WiFiClient::operator bool()
 {
     return _socket != NA_STATE;
 }
+
+IPAddress WiFiClient::remoteIP()
+{
+    struct sockaddr_in addr;
+    socklen_t len = sizeof(addr);
+
+    if (_socket == NA_STATE || getpeername(_socket, (struct sockaddr *)&addr, &len) < 0)
+        return IPAddress();
+    return IPAddress((uint32_t)addr.sin_addr.s_addr);
+}
@@ -23,8 +23,19 @@
 #include "Print.h"
 #include "Client.h"
 #include "IPAddress.h"
+#include "pico/time.h"
+#include <wolfssl/ssl.h>
 #include <wolfssh/ssh.h>
 
+#define KNOWN_HOSTS_FILE    "0:/known_hosts"    // Host keys seen, on the SD card
+#define KNOWN_HOST_NAME     64                  // Longest host:port remembered
+#define SSH_WINDOW_SIZE     (32 * 1024)         // Channel window, and the channel buffer wolfSSH mallocs for it
+#define SSH_MAX_PACKET      (8 * 1024)          // Largest data packet the server may send
+#define SSH_RX_SIZE         256                 // Decrypted bytes kept for Read() and peek()
+#define TLS_SESSIONS        4                   // Hosts whose TLS session is kept to resume
+#define CONNECT_TIMEOUT_MS  30000               // tcp_connect's limit
+#define CONNECT_WAIT        -1                  // connectPoll has no answer yet
+
 class WiFiClient : public Client
 {
 public:
@@ -35,8 +46,19 @@ public:
     static uint gCounter;
     
     virtual int ssh_connect(const char *username, const char *password);
+    int sshStart(const char *username, const char *password);
+    int sshPoll();
+    int checkHostKey(const uint8_t *pubKey, uint32_t pubKeySz);
+    bool hostKeyChanged = false;    // The last SSH handshake was refused the host's key
+    virtual int tls_connect(const char *hostName);
+    int tlsStart(const char *hostName);
+    int tlsPoll();
+    bool tlsResumed = false;        // The last TLS handshake skipped the full handshake
     virtual int tcp_connect(IPAddress ip, uint16_t port);
     virtual int tcp_connect(const char *host, uint16_t port);
+    int connectStart(IPAddress ip, uint16_t port, uint32_t timeoutMs);
+    int connectStart(const char *host, uint16_t port, uint32_t timeoutMs);
+    int connectPoll();
     virtual size_t Write(uint8_t);
     virtual size_t Write(const uint8_t *buf, size_t size);
     virtual int available();
@@ -50,15 +72,40 @@ public:
     virtual uint8_t connected();
     virtual uint8_t status();
     virtual operator bool();
+    IPAddress remoteIP();
 
     friend class WiFiServer;
+    friend int wsUserAuth(byte authType, WS_UserAuthData *authData, void *ctx);
+    friend int tlsRecv(WOLFSSL *ssl, char *buf, int sz, void *ctx);
+    friend int tlsSend(WOLFSSL *ssl, char *buf, int sz, void *ctx);
 
     using Print::Write;
 
 private:
-    WOLFSSH_CTX *ctx = NULL;
+    int sshFill();
+    int pending();
+    bool connectBegin();
+    void connectEnd();
+
+    static WOLFSSH_CTX *ctx;    // Made on the first SSH call and kept
     WOLFSSH *ssh = NULL;
+    bool sshHandshake = false;  // sshPoll has yet to log in
+    static WOLFSSL_CTX *tlsCtx; // Made, with the trust anchors loaded, on the first TLS call and kept
+    WOLFSSL *ssl = NULL;
+    bool tlsHandshake = false;  // tlsPoll has yet to finish the handshake
     uint16_t _socket;
+    char host[KNOWN_HOST_NAME]; // host:port of the last tcp_connect by name
+    bool connecting = false;
+    bool resolving = false;     // Waiting for DNS before the first attempt
+    IPAddress remote;
+    uint16_t remotePort = 0;
+    int attempt = -1;           // The socket still connecting
+    absolute_time_t connectDeadline;
+    const char *password = NULL;
+    bool keyTried = false;      // The SSHKey has been offered on this connection
+    uint8_t rx[SSH_RX_SIZE];    // Decrypted data not yet read, from rxHead to rxTail
+    uint16_t rxHead = 0;
+    uint16_t rxTail = 0;
 };
 
 #endif
@@ -0,0 +1,88 @@
+/*
+  WiFiServer.cpp - listen for incoming calls
+  Stefan Wessels, 2023
+*/
+#include "WiFiServer.h"
+#include <lwip/sockets.h>
+#include <string.h>
+
+/*
+ * Listen on port, without blocking, replacing any port listened on before
+ */
+bool WiFiServer::begin(uint16_t port)
+{
+    struct sockaddr_in addr;
+    int on = 1;
+
+    stop();
+    int s = socket(AF_INET, SOCK_STREAM, 0);
+    if (s < 0)
+        return false;
+    setsockopt(s, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (bind(s, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(s, SERVER_BACKLOG) < 0)
+    {
+        close(s);
+        return false;
+    }
+    _socket = s;
+    _port = port;
+    return true;
+}
+
+void WiFiServer::stop()
+{
+    if (_socket == NA_STATE)
+        return;
+    close(_socket);
+    _socket = NA_STATE;
+    _port = 0;
+}
+
+/*
+ * The next caller in the backlog, or -1 if none is waiting
+ */
+int WiFiServer::next()
+{
+    if (_socket == NA_STATE)
+        return -1;
+    int s = accept(_socket, NULL, NULL);
+    if (s < 0)
+        return -1;
+    // A call is blocking, as the rest of WiFiClient expects
+    fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) & ~O_NONBLOCK);
+    return s;
+}
+
+/*
+ * Make client the next caller.  false, and client is left alone, if no one
+ * is calling
+ */
+bool WiFiServer::answer(WiFiClient &client)
+{
+    int s = next();
+    if (s < 0)
+        return false;
+    client.stop();
+    client._socket = s;
+    return true;
+}
+
+/*
+ * Turn the next caller away with an RST, rather than a FIN, so it is not
+ * left waiting on a close.  false if no one is calling
+ */
+bool WiFiServer::refuse()
+{
+    struct linger hangUp = {1, 0};
+    int s = next();
+    if (s < 0)
+        return false;
+    setsockopt(s, SOL_SOCKET, SO_LINGER, &hangUp, sizeof(hangUp));
+    close(s);
+    return true;
+}
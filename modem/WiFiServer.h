@@ -0,0 +1,34 @@
+/*
+  WiFiServer.h - listen for incoming calls
+  Stefan Wessels, 2023
+*/
+#ifndef wifiserver_h
+#define wifiserver_h
+
+#include "WiFi.h"
+#include "WiFiClient.h"
+
+#define SERVER_BACKLOG      2       // Callers lwIP holds on to until they are accepted
+
+/*
+ * A TCP listener that never blocks.  Callers wait in lwIP's accept backlog
+ * until answer() hands the next one to a WiFiClient, or refuse() resets it,
+ * so a caller that can not be taken hears at once that the line is busy
+ */
+class WiFiServer
+{
+public:
+    bool begin(uint16_t port);
+    void stop();
+    uint16_t port() { return _port; }
+    bool answer(WiFiClient &client);
+    bool refuse();
+
+private:
+    int next();
+
+    uint16_t _socket = NA_STATE;
+    uint16_t _port = 0;     // 0 while not listening
+};
+
+#endif
@@ -3,4 +3,8 @@
 .type firmware, %object
 .balign 4
 firmware:
+.ifdef PRODOS_FIRMWARE
+.incbin "../../firmware/PRODOS.bin"
+.else
 .incbin "../../firmware/SSC.bin"
+.endif